@@ -0,0 +1,344 @@
+// Benchmarks of the override load pipeline against a stand-in settings
+// collection. Usage:
+//
+//     ccld_GameSettingsOverride_Bench [files keys_per_file unique_keys [repeat]]
+//
+// Without arguments a fixed set of workloads is run.
+
+#include <iostream>
+#include <random>
+
+#include <spdlog/sinks/null_sink.h>
+
+#include <XSEPlugin/Diagnostics.h>
+#include <XSEPlugin/GameSettings.h>
+#include <XSEPlugin/OriginalValues.h>
+#include <XSEPlugin/OverrideCache.h>
+#include <XSEPlugin/OverrideTable.h>
+#include <XSEPlugin/PatchProgram.h>
+#include <XSEPlugin/Pipeline.h>
+#include <XSEPlugin/SettingDump.h>
+#include <XSEPlugin/SettingResolver.h>
+#include <XSEPlugin/StringPool.h>
+#include <XSEPlugin/Util/Transcode.h>
+
+namespace
+{
+    std::atomic<std::uint64_t> g_allocs{ 0 };
+    std::atomic<std::uint64_t> g_bytes{ 0 };
+}
+
+void* operator new(std::size_t a_size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(a_size, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(a_size ? a_size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+// Kept out of line, or GCC pairs the free below with the replaced operator new
+// and reports them as mismatched.
+#ifdef __GNUC__
+[[gnu::noinline]]
+#endif
+void operator delete(void* a_ptr) noexcept
+{
+    std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::size_t) noexcept
+{
+    ::operator delete(a_ptr);
+}
+
+namespace
+{
+    struct Workload
+    {
+        std::size_t files;
+        std::size_t keysPerFile;
+        std::size_t uniqueKeys;
+    };
+
+    constexpr Workload kDefaultWorkloads[] = {
+        { 1, 10, 10 },
+        { 10, 100, 1000 },
+        { 100, 100, 1000 },
+        { 300, 50, 2000 },
+        { 1000, 100, 1000 },
+        { 10, 10000, 100000 },
+    };
+
+    constexpr std::string_view kPrefixes{ "bfirsu" };
+
+    std::string SettingName(std::size_t a_index)
+    {
+        return std::format("{}Bench{:06}", kPrefixes[a_index % kPrefixes.size()], a_index);
+    }
+
+    std::string SettingValue(std::size_t a_index, std::mt19937& a_rng)
+    {
+        switch (kPrefixes[a_index % kPrefixes.size()]) {
+        case 'b':
+            return (a_rng() & 1) ? "true" : "false";
+        case 'f':
+            return std::format("{:.3f}", std::uniform_real_distribution<float>{ 0.0f, 1000.0f }(a_rng));
+        case 'i':
+            return std::format("{}", static_cast<std::int32_t>(a_rng()));
+        case 'r':
+            return std::format("0x{:08X}", a_rng());
+        case 's':
+            return std::format("\"Value {}\"", a_rng() % 64);
+        default:
+            return std::format("{}", a_rng() % 100000);
+        }
+    }
+
+    /// Write a file that sets a window of consecutive keys at a random offset,
+    /// so that files overlap heavily when they hold more keys than there are
+    /// settings.
+    void WriteOverrideFile(const std::filesystem::path& a_path, const Workload& a_workload, std::mt19937& a_rng)
+    {
+        std::string doc;
+        const auto  keys = std::min(a_workload.keysPerFile, a_workload.uniqueKeys);
+        const auto  offset = a_rng() % a_workload.uniqueKeys;
+        for (std::size_t k = 0; k < keys; ++k) {
+            const auto index = (offset + k) % a_workload.uniqueKeys;
+            doc += std::format("{} = {}\n", SettingName(index), SettingValue(index, a_rng));
+        }
+
+        std::ofstream file{ a_path, std::ios_base::binary };
+        file << doc;
+    }
+
+    /// Fill the stand-in collection and write the override files.
+    void Generate(const Workload& a_workload, const std::filesystem::path& a_root)
+    {
+        auto collection = RE::GameSettingCollection::GetSingleton();
+        collection->Clear();
+        for (std::size_t i = 0; i < a_workload.uniqueKeys; ++i) {
+            collection->Add(SettingName(i));
+        }
+
+        std::filesystem::remove_all(a_root);
+        std::filesystem::create_directories(a_root);
+
+        std::mt19937 rng{ 42 };
+        for (std::size_t f = 0; f < a_workload.files; ++f) {
+            WriteOverrideFile(a_root / std::format("{:04}.toml", f), a_workload, rng);
+        }
+    }
+
+    struct Sample
+    {
+        double        ms{ std::numeric_limits<double>::max() };
+        std::uint64_t allocs{ 0 };
+        std::uint64_t bytes{ 0 };
+    };
+
+    /// Run `a_phase` `a_repeat` times; keep the best time and the allocations of one run.
+    template <class Setup, class Phase>
+    Sample Measure(std::size_t a_repeat, Setup&& a_setup, Phase&& a_phase)
+    {
+        Sample sample;
+        for (std::size_t i = 0; i < a_repeat; ++i) {
+            auto state = a_setup();
+
+            const auto allocs = g_allocs.load();
+            const auto bytes = g_bytes.load();
+            const auto start = std::chrono::steady_clock::now();
+            a_phase(state);
+            const auto stop = std::chrono::steady_clock::now();
+
+            sample.ms = std::min(sample.ms, std::chrono::duration<double, std::milli>(stop - start).count());
+            sample.allocs = g_allocs.load() - allocs;
+            sample.bytes = g_bytes.load() - bytes;
+        }
+        return sample;
+    }
+
+    void Print(std::string_view a_phase, const Sample& a_sample)
+    {
+        std::cout << std::format("  {:<28}{:>12.3f}{:>12}{:>14}\n", a_phase, a_sample.ms, a_sample.allocs,
+            a_sample.bytes);
+    }
+
+    std::vector<OverrideFile> ReadAll(OverrideCache& a_cache)
+    {
+        LoadStats stats;
+        return Pipeline::ReadOverrideFiles(Pipeline::ScanDir(GameSettings::root), a_cache, stats);
+    }
+
+    /// Convert file paths as the pipeline does, ASCII only and with other scripts.
+    void RunTranscode(std::size_t a_repeat)
+    {
+        constexpr std::size_t kPaths = 10000;
+
+        std::vector<std::u16string> ascii;
+        std::vector<std::u16string> mixed;
+        for (std::size_t i = 0; i < kPaths; ++i) {
+            const auto number = std::format("{:04}", i);
+            const auto suffix = std::u16string{ number.begin(), number.end() } + u".toml";
+            ascii.push_back(u"Data/SKSE/Plugins/ccld_GameSettingsOverride/Overrides_" + suffix);
+            mixed.push_back(u"Data/SKSE/Plugins/ccld_GameSettingsOverride/Überschreibungen_設定_" + suffix);
+        }
+        std::vector<std::string> utf8;
+        for (const auto& path : mixed) {
+            utf8.push_back(*Utf16ToUtf8(path));
+        }
+
+        std::cout << std::format("{} paths\n", kPaths);
+        std::cout << std::format("  {:<28}{:>12}{:>12}{:>14}\n", "phase", "time (ms)", "allocs", "bytes");
+
+        auto none = [] { return 0; };
+
+        std::array<char, 1024>     narrow;
+        std::array<char16_t, 1024> wide;
+        const auto                 toUtf8 = [&](const std::vector<std::u16string>& a_paths) {
+            std::size_t size = 0;
+            for (const auto& path : a_paths) {
+                size += Utf16ToUtf8(path, narrow).value_or(0);
+            }
+            return size;
+        };
+
+        Print("utf16 -> utf8, ascii", Measure(a_repeat, none, [&](int) { (void)toUtf8(ascii); }));
+        Print("utf16 -> utf8, mixed", Measure(a_repeat, none, [&](int) { (void)toUtf8(mixed); }));
+        Print("utf8 -> utf16, mixed", Measure(a_repeat, none, [&](int) {
+            for (const auto& path : utf8) {
+                (void)Utf8ToUtf16(path, wide);
+            }
+        }));
+        Print("utf16 -> utf8, allocating", Measure(a_repeat, none, [&](int) {
+            for (const auto& path : ascii) {
+                (void)Utf16ToUtf8(path);
+            }
+        }));
+
+        std::cout << '\n';
+    }
+
+    void Run(const Workload& a_workload, std::size_t a_repeat)
+    {
+        Generate(a_workload, GameSettings::root);
+
+        const auto total = a_workload.files * std::min(a_workload.keysPerFile, a_workload.uniqueKeys);
+        std::cout << std::format("{} files x {} keys, {} settings ({:.1f} writes per setting)\n", a_workload.files,
+            a_workload.keysPerFile, a_workload.uniqueKeys, static_cast<double>(total) / a_workload.uniqueKeys);
+        std::cout << std::format("  {:<28}{:>12}{:>12}{:>14}\n", "phase", "time (ms)", "allocs", "bytes");
+
+        auto none = [] { return 0; };
+
+        OverrideCache empty;
+        auto          files = ReadAll(empty);
+        auto          table = OverrideTable::Merge(files);
+
+        Print("scan", Measure(a_repeat, none, [](int) { (void)Pipeline::ScanDir(GameSettings::root); }));
+
+        Print("read + parse", Measure(a_repeat, none, [](int) {
+            OverrideCache cache;
+            (void)ReadAll(cache);
+        }));
+
+        Print("read, in-memory cache hit", Measure(
+            a_repeat, [&] { return OverrideCache::FromFiles(files); },
+            [](OverrideCache& a_cache) { (void)ReadAll(a_cache); }));
+
+        const auto cachePath = std::filesystem::current_path() / "bench.cache";
+        Print("cache save", Measure(a_repeat, none, [&](int) { OverrideCache::Save(cachePath, files); }));
+        Print("cache open", Measure(a_repeat, none, [&](int) { (void)OverrideCache::Open(cachePath); }));
+
+        Print("merge", Measure(a_repeat, none, [&](int) { (void)OverrideTable::Merge(files); }));
+
+        Print("compile, all written", Measure(a_repeat, none, [&](int) {
+            (void)PatchProgram::Compile(table, nullptr);
+        }));
+
+        Print("compile, nothing changed", Measure(a_repeat, none, [&](int) {
+            (void)PatchProgram::Compile(table, &table);
+        }));
+
+        Print("resolve", Measure(
+            a_repeat, [&] { return PatchProgram::Compile(table, nullptr); },
+            [](PatchProgram& a_program) { a_program.Resolve(*SettingResolver::GetSingleton()); }));
+
+        auto program = PatchProgram::Compile(table, nullptr);
+        program.Resolve(*SettingResolver::GetSingleton());
+        Print("commit", Measure(
+            a_repeat, [] { return std::pair<StringPool, OriginalValues>{}; },
+            [&](auto& a_state) { program.Commit(a_state.first, a_state.second); }));
+
+        Print("log, every setting", Measure(a_repeat, none, [&](int) { program.Log(); }));
+
+        Diagnostics::SetSummary(true);
+        Print("log, summary", Measure(a_repeat, none, [&](int) { program.Log(); }));
+        Diagnostics::SetSummary(false);
+
+        const auto diskCache = *SKSE::log::log_directory() / "ccld_GameSettingsOverride.cache";
+        Print("Load (cold cache)", Measure(
+            a_repeat, [&] { return std::filesystem::remove(diskCache); }, [](bool) { GameSettings::Load(false); }));
+
+        Print("Load (warm cache)", Measure(a_repeat, none, [](int) { GameSettings::Load(false); }));
+
+        Print("drift check", Measure(a_repeat, none, [](int) { GameSettings::CheckDrift(true); }));
+
+        SettingDump            dump;
+        std::array<char, 4096> page;
+        Print("dump page", Measure(a_repeat, none, [&](int) { dump.WritePage(page.data(), page.size()); }));
+
+        Print("Reload (nothing changed)", Measure(a_repeat, none, [](int) { GameSettings::Reload(); }));
+
+        Print("RevertAll, then Reload", Measure(a_repeat, none, [](int) {
+            GameSettings::RevertAll();
+            GameSettings::Reload();
+        }));
+
+        // Two profiles of one file each, switched back and forth.
+        std::mt19937 rng{ 7 };
+        for (auto name : { "A"sv, "B"sv }) {
+            const auto dir = GameSettings::root / "Profiles" / name;
+            std::filesystem::create_directories(dir);
+            WriteOverrideFile(dir / "profile.toml", a_workload, rng);
+        }
+        GameSettings::Load(false, "A"sv);
+
+        std::size_t switches = 0;
+        Print("switch profile", Measure(
+            a_repeat, [&] { return ++switches % 2 ? "B"sv : "A"sv; },
+            [](std::string_view a_name) { GameSettings::SwitchProfile(a_name); }));
+
+        std::cout << '\n';
+    }
+}
+
+int main(int a_argc, char* a_argv[])
+{
+    // Logging is formatted as in the game, but not written anywhere.
+    auto logger = std::make_shared<spdlog::logger>("Global", std::make_shared<spdlog::sinks::null_sink_mt>());
+    logger->set_level(spdlog::level::info);
+    spdlog::set_default_logger(std::move(logger));
+
+    const auto workspace = std::filesystem::temp_directory_path() / "ccld_GameSettingsOverride_Bench";
+    std::filesystem::create_directories(workspace);
+    std::filesystem::current_path(workspace);
+
+    std::size_t repeat = 5;
+    RunTranscode(repeat);
+    if (a_argc >= 4) {
+        const Workload workload{ std::stoull(a_argv[1]), std::stoull(a_argv[2]), std::stoull(a_argv[3]) };
+        if (a_argc >= 5) {
+            repeat = std::stoull(a_argv[4]);
+        }
+        Run(workload, repeat);
+    } else {
+        for (const auto& workload : kDefaultWorkloads) {
+            Run(workload, repeat);
+        }
+    }
+
+    std::filesystem::current_path(std::filesystem::temp_directory_path());
+    std::filesystem::remove_all(workspace);
+    return 0;
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <cassert>
+#include <cctype>
+#include <cerrno>
+#include <cfloat>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <execution>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <initializer_list>
+#include <ios>
+#include <istream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <set>
+#include <shared_mutex>
+#include <source_location>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <version>
+
+#include <spdlog/spdlog.h>
+
+#include <XSEPlugin/Util/String.h>
+
+using namespace std::literals::string_view_literals;
+
+// Stand-ins for the parts of CommonLibSSE the load pipeline uses, so that it
+// builds and runs without the game.
+
+namespace RE
+{
+    struct Color
+    {
+        Color() = default;
+
+        constexpr Color(std::uint32_t a_red, std::uint32_t a_green, std::uint32_t a_blue,
+            std::uint32_t a_alpha) noexcept :
+            red(static_cast<std::uint8_t>(a_red)),
+            green(static_cast<std::uint8_t>(a_green)),
+            blue(static_cast<std::uint8_t>(a_blue)),
+            alpha(static_cast<std::uint8_t>(a_alpha))
+        {}
+
+        std::uint8_t red;
+        std::uint8_t green;
+        std::uint8_t blue;
+        std::uint8_t alpha;
+    };
+
+    class Setting
+    {
+    public:
+        enum class Type
+        {
+            kUnknown = 0,
+            kBool,
+            kFloat,
+            kSignedInteger,
+            kColor,
+            kString,
+            kUnsignedInteger,
+        };
+
+        union Data
+        {
+            bool          b;
+            float         f;
+            std::int32_t  i;
+            Color         r;
+            char*         s;
+            std::uint32_t u;
+        };
+
+        explicit Setting(const char* a_name) noexcept : data(), name(a_name) {}
+
+        // Like the game, the type is given by the first letter of the name.
+        [[nodiscard]] Type GetType() const noexcept
+        {
+            switch (name[0]) {
+            case 'b':
+                return Type::kBool;
+            case 'f':
+                return Type::kFloat;
+            case 'i':
+                return Type::kSignedInteger;
+            case 'r':
+                return Type::kColor;
+            case 'S':
+            case 's':
+                return Type::kString;
+            case 'u':
+                return Type::kUnsignedInteger;
+            default:
+                return Type::kUnknown;
+            }
+        }
+
+        [[nodiscard]] const char* GetName() const noexcept { return name; }
+
+        Data        data;
+        const char* name;
+    };
+
+    /// Owns its settings and finds them through a case-insensitive hash map,
+    /// as the game's collection does.
+    class GameSettingCollection
+    {
+    public:
+        [[nodiscard]] static GameSettingCollection* GetSingleton()
+        {
+            static GameSettingCollection singleton;
+            return std::addressof(singleton);
+        }
+
+        [[nodiscard]] Setting* GetSetting(const char* a_name) const
+        {
+            auto it = _settings.find(std::string_view{ a_name });
+            return it != _settings.end() ? it->second.get() : nullptr;
+        }
+
+        Setting* Add(std::string a_name)
+        {
+            auto& name = _names.emplace_back(std::move(a_name));
+            auto  setting = std::make_unique<Setting>(name.c_str());
+            auto  ptr = setting.get();
+            _settings.insert_or_assign(std::string_view{ name }, std::move(setting));
+            return ptr;
+        }
+
+        void Clear() noexcept
+        {
+            _settings.clear();
+            _names.clear();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return _settings.size(); }
+
+    private:
+        using Map =
+            std::unordered_map<std::string_view, std::unique_ptr<Setting>, CaseInsensitiveHash, CaseInsensitiveEqual>;
+
+        std::deque<std::string> _names;
+        Map                     _settings;
+    };
+
+    /// Owns its settings and keeps them in a list, as the game's INI
+    /// collections do.
+    class INISettingCollection
+    {
+    public:
+        [[nodiscard]] static INISettingCollection* GetSingleton()
+        {
+            static INISettingCollection singleton;
+            return std::addressof(singleton);
+        }
+
+        Setting* Add(std::string a_name)
+        {
+            auto& name = _names.emplace_back(std::move(a_name));
+            auto& setting = _owned.emplace_back(name.c_str());
+            settings.push_back(std::addressof(setting));
+            return std::addressof(setting);
+        }
+
+        std::list<Setting*> settings;
+
+    private:
+        std::deque<std::string> _names;
+        std::deque<Setting>     _owned;
+    };
+
+    class INIPrefSettingCollection : public INISettingCollection
+    {
+    public:
+        [[nodiscard]] static INIPrefSettingCollection* GetSingleton()
+        {
+            static INIPrefSettingCollection singleton;
+            return std::addressof(singleton);
+        }
+    };
+}
+
+namespace SKSE
+{
+    namespace log
+    {
+        template <class... Args>
+        void debug(std::format_string<Args...> a_fmt, Args&&... a_args)
+        {
+            spdlog::debug("{}", std::format(a_fmt, std::forward<Args>(a_args)...));
+        }
+
+        template <class... Args>
+        void info(std::format_string<Args...> a_fmt, Args&&... a_args)
+        {
+            spdlog::info("{}", std::format(a_fmt, std::forward<Args>(a_args)...));
+        }
+
+        template <class... Args>
+        void warn(std::format_string<Args...> a_fmt, Args&&... a_args)
+        {
+            spdlog::warn("{}", std::format(a_fmt, std::forward<Args>(a_args)...));
+        }
+
+        template <class... Args>
+        void error(std::format_string<Args...> a_fmt, Args&&... a_args)
+        {
+            spdlog::error("{}", std::format(a_fmt, std::forward<Args>(a_args)...));
+        }
+
+        // The benchmark runs in a scratch directory, which also takes the cache.
+        [[nodiscard]] inline std::optional<std::filesystem::path> log_directory()
+        {
+            return std::filesystem::current_path();
+        }
+    }
+
+    namespace stl
+    {
+        [[nodiscard]] inline auto ansi_to_utf8(std::string_view a_in) noexcept -> std::optional<std::string>
+        {
+            return std::string{ a_in };
+        }
+
+        [[noreturn]] inline void report_fatal_error(const std::string& a_msg, bool a_abort)
+        {
+            spdlog::error("{}", a_msg);
+            if (a_abort) {
+                std::abort();
+            }
+            throw std::runtime_error(a_msg);
+        }
+    }
+
+    class PluginDeclaration
+    {
+    public:
+        [[nodiscard]] static PluginDeclaration* GetSingleton() noexcept
+        {
+            static PluginDeclaration singleton;
+            return std::addressof(singleton);
+        }
+
+        [[nodiscard]] std::string_view GetName() const noexcept { return "ccld_GameSettingsOverride"sv; }
+    };
+}
+
+[[nodiscard]] inline std::filesystem::path StrToPath(std::string_view a_str)
+{
+    return std::filesystem::path{ std::u8string_view{ reinterpret_cast<const char8_t*>(a_str.data()), a_str.size() } };
+}
+
+[[nodiscard]] inline std::string PathToStr(const std::filesystem::path& a_path)
+{
+    auto str = a_path.u8string();
+    return std::string{ reinterpret_cast<const char*>(str.data()), str.size() };
+}
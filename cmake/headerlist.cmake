@@ -1,8 +1,35 @@
 set(PROJECT_HEADERS
+    "src/XSEPlugin/AppliedLoad.h"
+    "src/XSEPlugin/Configuration.h"
+    "src/XSEPlugin/Diagnostics.h"
+    "src/XSEPlugin/DirectoryWatcher.h"
+    "src/XSEPlugin/DriftWatch.h"
+    "src/XSEPlugin/Expression.h"
     "src/XSEPlugin/Function.h"
     "src/XSEPlugin/GameSettings.h"
+    "src/XSEPlugin/HotReload.h"
+    "src/XSEPlugin/LoadStats.h"
+    "src/XSEPlugin/OriginalValues.h"
+    "src/XSEPlugin/Override.h"
+    "src/XSEPlugin/OverrideCache.h"
+    "src/XSEPlugin/OverrideTable.h"
     "src/XSEPlugin/PCH.h"
+    "src/XSEPlugin/PatchProgram.h"
+    "src/XSEPlugin/Pipeline.h"
+    "src/XSEPlugin/ReloadQueue.h"
+    "src/XSEPlugin/SettingDump.h"
+    "src/XSEPlugin/SettingResolver.h"
+    "src/XSEPlugin/SettingType.h"
+    "src/XSEPlugin/StringPool.h"
+    "src/XSEPlugin/Util/CaptureBuffer.h"
+    "src/XSEPlugin/Util/File.h"
+    "src/XSEPlugin/Util/Hash.h"
+    "src/XSEPlugin/Util/MappedFile.h"
     "src/XSEPlugin/Util/Singleton.h"
+    "src/XSEPlugin/Util/Snapshot.h"
+    "src/XSEPlugin/Util/String.h"
     "src/XSEPlugin/Util/TOML.h"
+    "src/XSEPlugin/Util/Transcode.h"
     "src/XSEPlugin/Util/Win.h"
+    "src/XSEPlugin/Watchdog.h"
 )
@@ -1,6 +1,26 @@
 set(PROJECT_SOURCES
+    "src/XSEPlugin/Configuration.cpp"
+    "src/XSEPlugin/Diagnostics.cpp"
+    "src/XSEPlugin/DirectoryWatcher.cpp"
+    "src/XSEPlugin/DriftWatch.cpp"
+    "src/XSEPlugin/Expression.cpp"
     "src/XSEPlugin/Function.cpp"
     "src/XSEPlugin/GameSettings.cpp"
+    "src/XSEPlugin/HotReload.cpp"
+    "src/XSEPlugin/LoadStats.cpp"
     "src/XSEPlugin/Main.cpp"
+    "src/XSEPlugin/OriginalValues.cpp"
+    "src/XSEPlugin/Override.cpp"
+    "src/XSEPlugin/OverrideCache.cpp"
+    "src/XSEPlugin/OverrideTable.cpp"
+    "src/XSEPlugin/PatchProgram.cpp"
+    "src/XSEPlugin/Pipeline.cpp"
+    "src/XSEPlugin/ReloadQueue.cpp"
+    "src/XSEPlugin/SettingDump.cpp"
+    "src/XSEPlugin/SettingResolver.cpp"
+    "src/XSEPlugin/StringPool.cpp"
+    "src/XSEPlugin/Util/MappedFile.cpp"
+    "src/XSEPlugin/Util/Transcode.cpp"
     "src/XSEPlugin/Util/Win.cpp"
+    "src/XSEPlugin/Watchdog.cpp"
 )
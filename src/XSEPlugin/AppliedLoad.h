@@ -0,0 +1,66 @@
+#pragma once
+
+#include <XSEPlugin/OverrideTable.h>
+#include <XSEPlugin/SettingResolver.h>
+#include <XSEPlugin/SettingType.h>
+
+/// The effective overrides of the shared files together with the files of
+/// one profile.
+struct Profile
+{
+    std::string   name;   // Empty for the shared files alone.
+    OverrideTable table;  // File indices refer to LoadedFiles::files.
+};
+
+/// Everything read from the override files, shared by all profile switches.
+struct LoadedFiles
+{
+    std::vector<OverrideFile> files;     // Shared files, then the files of each profile, in scan order.
+    std::vector<Profile>      profiles;  // The shared files alone first, then each profile by name.
+};
+
+/// One override in effect, with the file it comes from.
+struct EffectiveOverride
+{
+    std::string_view             name;
+    RE::Setting::Type            type;  // Given by the name.
+    const OverrideValue*         value;
+    const std::filesystem::path* source;
+};
+
+/// The files and overrides that are in effect in the game. Never modified once
+/// published; every load, reload, profile switch and revert publishes a new one.
+struct AppliedLoad
+{
+    std::shared_ptr<const LoadedFiles> loaded{ std::make_shared<const LoadedFiles>() };
+    std::size_t                        profile{ 0 };       // Index into `loaded->profiles`.
+    bool                               applied{ false };  // False before the first load and after RevertAll.
+
+    [[nodiscard]] const Profile* GetProfile() const noexcept
+    {
+        return profile < loaded->profiles.size() ? std::addressof(loaded->profiles[profile]) : nullptr;
+    }
+
+    /// The overrides in effect; empty if none are.
+    [[nodiscard]] const OverrideTable& table() const noexcept
+    {
+        static const OverrideTable empty;
+        auto                       current = GetProfile();
+        return applied && current ? current->table : empty;
+    }
+
+    [[nodiscard]] EffectiveOverride Describe(const OverrideTable::Entry& a_entry) const noexcept
+    {
+        return { a_entry.name, SettingTypeOf(SplitName(a_entry.name).name), std::addressof(a_entry.value),
+            std::addressof(loaded->files[a_entry.file].path) };
+    }
+
+    /// The override in effect for the setting `a_name`, if there is one.
+    [[nodiscard]] std::optional<EffectiveOverride> Find(std::string_view a_name) const noexcept
+    {
+        if (auto entry = table().Find(a_name)) {
+            return Describe(*entry);
+        }
+        return std::nullopt;
+    }
+};
@@ -0,0 +1,82 @@
+#include "Configuration.h"
+
+#include <toml++/toml.hpp>
+
+#include <XSEPlugin/Util/TOML.h>
+
+namespace
+{
+    inline void LoadHotReload(Configuration::HotReload& a_config, const toml::table& a_table, TOMLIssues& a_issues)
+    {
+        constexpr auto name = "HotReload"sv;
+        if (auto section = TryGetTOMLSection(a_table, name); a_issues.Check(section) && *section) {
+            a_issues.Check(TryGetTOMLValue(**section, "enable"sv, a_config.enable), name);
+            a_issues.Check(TryGetTOMLValue(**section, "debounce"sv, a_config.debounce), name);
+            a_issues.Check(TryGetTOMLValue(**section, "poll_interval"sv, a_config.pollInterval), name);
+        }
+    }
+
+    inline void LoadProfiles(Configuration::Profiles& a_config, const toml::table& a_table, TOMLIssues& a_issues)
+    {
+        constexpr auto name = "Profiles"sv;
+        if (auto section = TryGetTOMLSection(a_table, name); a_issues.Check(section) && *section) {
+            a_issues.Check(TryGetTOMLValue(**section, "active"sv, a_config.active), name);
+        }
+    }
+
+    inline void LoadWatchdog(Configuration::Watchdog& a_config, const toml::table& a_table, TOMLIssues& a_issues)
+    {
+        constexpr auto name = "Watchdog"sv;
+        if (auto section = TryGetTOMLSection(a_table, name); a_issues.Check(section) && *section) {
+            a_issues.Check(TryGetTOMLValue(**section, "enable"sv, a_config.enable), name);
+            a_issues.Check(TryGetTOMLValue(**section, "interval"sv, a_config.interval), name);
+            a_issues.Check(TryGetTOMLValue(**section, "reassert"sv, a_config.reassert), name);
+        }
+    }
+
+    inline void LoadLogging(Configuration::Logging& a_config, const toml::table& a_table, TOMLIssues& a_issues)
+    {
+        constexpr auto name = "Logging"sv;
+        if (auto section = TryGetTOMLSection(a_table, name); a_issues.Check(section) && *section) {
+            a_issues.Check(TryGetTOMLValue(**section, "async"sv, a_config.async), name);
+            a_issues.Check(TryGetTOMLValue(**section, "flush_interval"sv, a_config.flushInterval), name);
+            a_issues.Check(TryGetTOMLValue(**section, "summary"sv, a_config.summary), name);
+        }
+    }
+}
+
+void Configuration::Init(bool a_abort)
+{
+    auto tmp = std::unique_ptr<Configuration, Deleter>{ new Configuration };
+
+    try {
+        if (std::filesystem::exists(path)) {
+            auto data = LoadTOMLFile(path);
+
+            // Every mistake is reported at once, rather than one per launch.
+            TOMLIssues issues;
+            LoadHotReload(tmp->hotReload, data, issues);
+            LoadProfiles(tmp->profiles, data, issues);
+            LoadWatchdog(tmp->watchdog, data, issues);
+            LoadLogging(tmp->logging, data, issues);
+            if (!issues.empty()) {
+                throw TOMLError(issues.message());
+            }
+        }
+    } catch (const toml::parse_error& e) {
+        auto msg = std::format("Failed to load \"{}\" (error occurred at line {}, column {}): {}.", PathToStr(path),
+            e.source().begin.line, e.source().begin.column, e.what());
+        SKSE::stl::report_fatal_error(msg, a_abort);
+    } catch (const std::system_error& e) {
+        auto msg = std::format("Failed to load \"{}\": {}.", PathToStr(path),
+            SKSE::stl::ansi_to_utf8(e.what()).value_or(e.what()));
+        SKSE::stl::report_fatal_error(msg, a_abort);
+    } catch (const std::exception& e) {
+        auto msg = std::format("Failed to load \"{}\": {}.", PathToStr(path), e.what());
+        SKSE::stl::report_fatal_error(msg, a_abort);
+    }
+
+    auto lock = LockUnique();
+    _singleton = std::move(tmp);
+    IncrementVersion();
+}
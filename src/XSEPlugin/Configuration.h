@@ -0,0 +1,44 @@
+#pragma once
+
+#include <XSEPlugin/Util/Singleton.h>
+
+/// Options of the plugin itself, as opposed to the game settings it overrides.
+class Configuration : public SingletonEx<Configuration>
+{
+public:
+    /// Read the configuration file, or fall back to defaults if there is none.
+    static void Init(bool a_abort = true);
+
+    struct HotReload
+    {
+        bool          enable{ false };
+        std::uint32_t debounce{ 500 };    // Quiet time in milliseconds before a burst of changes is reloaded.
+        std::uint32_t pollInterval{ 0 };  // Poll interval in milliseconds; 0 uses file system notifications.
+    };
+
+    struct Profiles
+    {
+        std::string active;  // Profile applied at startup; empty for none.
+    };
+
+    struct Watchdog
+    {
+        bool          enable{ false };
+        std::uint32_t interval{ 5000 };  // Check interval in milliseconds; 0 only checks on loading a game.
+        bool          reassert{ true };  // Write back settings changed by other mods, instead of only logging them.
+    };
+
+    struct Logging
+    {
+        bool          async{ false };      // Write the log file on a background thread.
+        std::uint32_t flushInterval{ 0 };  // Flush interval in milliseconds; 0 flushes after every message.
+        bool          summary{ false };    // Log counts instead of every setting, which is then logged at debug level.
+    };
+
+    HotReload hotReload;
+    Profiles  profiles;
+    Watchdog  watchdog;
+    Logging   logging;
+
+    static inline const std::filesystem::path path{ L"Data/SKSE/Plugins/ccld_GameSettingsOverride.toml"sv };
+};
@@ -0,0 +1,42 @@
+#include "Diagnostics.h"
+
+namespace
+{
+    inline void Append(Diagnostics::Buffer& a_buffer, spdlog::level::level_enum a_level, std::string_view a_msg)
+    {
+        const auto level = spdlog::level::to_string_view(a_level);
+        a_buffer.Append({ "["sv, std::string_view{ level.data(), level.size() }, "] "sv, a_msg, "\n"sv });
+    }
+}
+
+Diagnostics::Capture::Capture(Buffer& a_buffer) noexcept
+{
+    a_buffer.Clear();
+    _previous = std::exchange(_capture, std::addressof(a_buffer));
+}
+
+Diagnostics::Capture::~Capture() noexcept
+{
+    _capture = _previous;
+}
+
+void Diagnostics::CaptureOnly(spdlog::level::level_enum a_level, std::string_view a_msg) noexcept
+{
+    if (auto capture = _capture) {
+        Append(*capture, a_level, a_msg);
+    }
+}
+
+void Diagnostics::Write(spdlog::logger* a_logger, Buffer* a_capture, spdlog::level::level_enum a_level,
+    std::string_view a_msg) noexcept
+{
+    try {
+        a_logger->log(a_level, a_msg);
+    } catch (...) {
+        // Logging must never fail a load.
+    }
+
+    if (a_capture) {
+        Append(*a_capture, a_level, a_msg);
+    }
+}
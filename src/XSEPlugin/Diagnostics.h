@@ -0,0 +1,112 @@
+#pragma once
+
+#include <XSEPlugin/Util/CaptureBuffer.h>
+
+/// Messages of the load pipeline. They always go to the log file, and while a
+/// Capture is active on the thread that logs them also to its buffer, e.g. for
+/// the reply of an MFM function. The shared logger is never reconfigured for
+/// this, and messages of other threads never land in the buffer.
+///
+/// Messages about single settings are details. At summary verbosity they are
+/// logged at debug level, and only the counts are logged at info level.
+class Diagnostics
+{
+public:
+    using Buffer = CaptureBuffer<8 * 1024>;
+
+    /// Copies diagnostics of the current thread to a buffer for as long as it
+    /// lives. Captures on one thread nest.
+    class Capture
+    {
+    public:
+        explicit Capture(Buffer& a_buffer) noexcept;
+        ~Capture() noexcept;
+
+        Capture(const Capture&) = delete;
+        Capture(Capture&&) = delete;
+        Capture& operator=(const Capture&) = delete;
+        Capture& operator=(Capture&&) = delete;
+
+    private:
+        Buffer* _previous;
+    };
+
+    static constexpr std::string_view kTruncated{ "\n... (truncated)" };
+
+    template <class... Args>
+    static void Log(spdlog::level::level_enum a_level, std::format_string<Args...> a_fmt, Args&&... a_args)
+    {
+        auto logger = spdlog::default_logger_raw();
+        auto capture = a_level >= spdlog::level::info ? _capture : nullptr;
+        if (!capture && !logger->should_log(a_level)) {
+            return;
+        }
+
+        // Most messages fit on the stack.
+        std::array<char, 512> buf;
+        auto result = std::format_to_n(buf.data(), buf.size(), a_fmt, std::forward<Args>(a_args)...);
+        if (static_cast<std::size_t>(result.size) <= buf.size()) {
+            Write(logger, capture, a_level, { buf.data(), static_cast<std::size_t>(result.size) });
+        } else {
+            // Formatting never moves from its arguments, so they can be forwarded again.
+            Write(logger, capture, a_level, std::format(a_fmt, std::forward<Args>(a_args)...));
+        }
+    }
+
+    template <class... Args>
+    static void Debug(std::format_string<Args...> a_fmt, Args&&... a_args)
+    {
+        Log(spdlog::level::debug, a_fmt, std::forward<Args>(a_args)...);
+    }
+
+    template <class... Args>
+    static void Detail(std::format_string<Args...> a_fmt, Args&&... a_args)
+    {
+        Log(GetDetailLevel(), a_fmt, std::forward<Args>(a_args)...);
+    }
+
+    template <class... Args>
+    static void Info(std::format_string<Args...> a_fmt, Args&&... a_args)
+    {
+        Log(spdlog::level::info, a_fmt, std::forward<Args>(a_args)...);
+    }
+
+    template <class... Args>
+    static void Warn(std::format_string<Args...> a_fmt, Args&&... a_args)
+    {
+        Log(spdlog::level::warn, a_fmt, std::forward<Args>(a_args)...);
+    }
+
+    template <class... Args>
+    static void Error(std::format_string<Args...> a_fmt, Args&&... a_args)
+    {
+        Log(spdlog::level::err, a_fmt, std::forward<Args>(a_args)...);
+    }
+
+    /// Add a message that was already logged elsewhere to the active capture of
+    /// the current thread.
+    static void CaptureOnly(spdlog::level::level_enum a_level, std::string_view a_msg) noexcept;
+
+    /// Whether a message of `a_level` would be logged or captured.
+    [[nodiscard]] static bool ShouldLog(spdlog::level::level_enum a_level) noexcept
+    {
+        return (a_level >= spdlog::level::info && _capture) ||
+               spdlog::default_logger_raw()->should_log(a_level);
+    }
+
+    static void SetSummary(bool a_summary) noexcept { _summary.store(a_summary, std::memory_order_relaxed); }
+
+    [[nodiscard]] static bool IsSummary() noexcept { return _summary.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] static spdlog::level::level_enum GetDetailLevel() noexcept
+    {
+        return IsSummary() ? spdlog::level::debug : spdlog::level::info;
+    }
+
+private:
+    static void Write(spdlog::logger* a_logger, Buffer* a_capture, spdlog::level::level_enum a_level,
+        std::string_view a_msg) noexcept;
+
+    static inline thread_local Buffer* _capture{ nullptr };
+    static inline std::atomic<bool>    _summary{ false };
+};
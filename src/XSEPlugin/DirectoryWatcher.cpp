@@ -0,0 +1,119 @@
+#include "DirectoryWatcher.h"
+
+PollingWatchBackend::PollingWatchBackend(std::filesystem::path a_path, std::chrono::milliseconds a_interval) :
+    _path(std::move(a_path)), _interval(a_interval), _snapshot(Scan(_path))
+{}
+
+WatchBackend::Result PollingWatchBackend::Wait(std::optional<std::chrono::milliseconds> a_timeout)
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto deadline = a_timeout ? clock::now() + *a_timeout : clock::time_point::max();
+
+    std::unique_lock lock{ _mutex };
+    while (true) {
+        if (_cv.wait_until(lock, std::min(clock::now() + _interval, deadline), [this] { return _cancelled; })) {
+            return Result::kCancelled;
+        }
+
+        if (auto snapshot = Scan(_path); snapshot != _snapshot) {
+            _snapshot = std::move(snapshot);
+            return Result::kChanged;
+        }
+
+        if (clock::now() >= deadline) {
+            return Result::kTimeout;
+        }
+    }
+}
+
+void PollingWatchBackend::Cancel() noexcept
+{
+    {
+        std::scoped_lock lock{ _mutex };
+        _cancelled = true;
+    }
+    _cv.notify_all();
+}
+
+auto PollingWatchBackend::Scan(const std::filesystem::path& a_path) -> Snapshot
+{
+    Snapshot        snapshot;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it{ a_path, ec }, end; !ec && it != end; it.increment(ec)) {
+        // A file that goes away or is locked while an editor saves it is left
+        // out, rather than ending the scan.
+        std::error_code entryError;
+        if (!it->is_regular_file(entryError) || entryError) {
+            continue;
+        }
+        const auto size = it->file_size(entryError);
+        if (entryError) {
+            continue;
+        }
+        const auto mtime = it->last_write_time(entryError);
+        if (entryError) {
+            continue;
+        }
+        snapshot.emplace_back(it->path(), size, mtime);
+    }
+
+    std::ranges::sort(snapshot);
+    return snapshot;
+}
+
+#ifdef _WIN32
+WatchBackend::Result NativeWatchBackend::Wait(std::optional<std::chrono::milliseconds> a_timeout)
+{
+    switch (_monitor.Wait(a_timeout)) {
+    case Win::DirectoryMonitor::Result::kChanged:
+        return Result::kChanged;
+    case Win::DirectoryMonitor::Result::kTimeout:
+        return Result::kTimeout;
+    default:
+        return Result::kCancelled;
+    }
+}
+#endif
+
+DirectoryWatcher::DirectoryWatcher(std::unique_ptr<WatchBackend> a_backend, std::chrono::milliseconds a_debounce,
+    Callback a_callback) :
+    _backend(std::move(a_backend)), _debounce(a_debounce), _callback(std::move(a_callback))
+{
+    _thread = std::thread{ &DirectoryWatcher::Run, this };
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    _backend->Cancel();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void DirectoryWatcher::Run()
+{
+    while (true) {
+        // Idle until the first change of a burst.
+        if (_backend->Wait(std::nullopt) != WatchBackend::Result::kChanged) {
+            return;
+        }
+
+        // Then wait until the directory has been quiet for the debounce time.
+        for (auto result = _backend->Wait(_debounce); result != WatchBackend::Result::kTimeout;
+             result = _backend->Wait(_debounce)) {
+            if (result == WatchBackend::Result::kCancelled) {
+                return;
+            }
+        }
+
+        try {
+            _callback();
+        } catch (const std::exception& e) {
+            SKSE::log::error("Directory watcher callback failed: {}.", e.what());
+        } catch (...) {
+            // Nothing may escape the thread, which would terminate the game.
+            SKSE::log::error("Directory watcher callback failed: unknown error.");
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#ifdef _WIN32
+#    include <XSEPlugin/Util/Win.h>
+#endif
+
+/// Source of change notifications for one directory.
+class WatchBackend
+{
+public:
+    enum class Result
+    {
+        kChanged,
+        kTimeout,
+        kCancelled,
+    };
+
+    virtual ~WatchBackend() = default;
+
+    /// Block until the directory may have changed, `a_timeout` passed, or Cancel was called.
+    [[nodiscard]] virtual Result Wait(std::optional<std::chrono::milliseconds> a_timeout) = 0;
+
+    /// Wake up Wait for good. May be called from any thread.
+    virtual void Cancel() noexcept = 0;
+};
+
+/// Compares the size and modification time of every file, in subdirectories
+/// too, at a fixed interval.
+/// Works anywhere, but wakes up once per interval while idle.
+class PollingWatchBackend final : public WatchBackend
+{
+public:
+    PollingWatchBackend(std::filesystem::path a_path, std::chrono::milliseconds a_interval);
+
+    [[nodiscard]] Result Wait(std::optional<std::chrono::milliseconds> a_timeout) override;
+
+    void Cancel() noexcept override;
+
+private:
+    using Snapshot = std::vector<std::tuple<std::filesystem::path, std::uintmax_t, std::filesystem::file_time_type>>;
+
+    [[nodiscard]] static Snapshot Scan(const std::filesystem::path& a_path);
+
+    std::filesystem::path     _path;
+    std::chrono::milliseconds _interval;
+    Snapshot                  _snapshot;
+    std::mutex                _mutex;
+    std::condition_variable   _cv;
+    bool                      _cancelled{ false };
+};
+
+#ifdef _WIN32
+/// Sleeps on file system notifications, so it costs nothing while idle.
+class NativeWatchBackend final : public WatchBackend
+{
+public:
+    explicit NativeWatchBackend(const std::filesystem::path& a_path) : _monitor(a_path) {}
+
+    [[nodiscard]] Result Wait(std::optional<std::chrono::milliseconds> a_timeout) override;
+
+    void Cancel() noexcept override { _monitor.Cancel(); }
+
+private:
+    Win::DirectoryMonitor _monitor;
+};
+#endif
+
+/// Calls back once after each burst of changes in a directory. A burst ends
+/// when no change was seen for the debounce time, so "write temp file, rename,
+/// touch" sequences of editors trigger a single callback.
+class DirectoryWatcher
+{
+public:
+    using Callback = std::function<void()>;
+
+    DirectoryWatcher(std::unique_ptr<WatchBackend> a_backend, std::chrono::milliseconds a_debounce,
+        Callback a_callback);
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher(DirectoryWatcher&&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(DirectoryWatcher&&) = delete;
+
+private:
+    void Run();
+
+    std::unique_ptr<WatchBackend> _backend;
+    std::chrono::milliseconds     _debounce;
+    Callback                      _callback;
+    std::thread                   _thread;
+};
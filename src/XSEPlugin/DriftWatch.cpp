@@ -0,0 +1,113 @@
+#include "DriftWatch.h"
+
+namespace
+{
+    inline std::uint64_t LoadData(const RE::Setting* a_setting) noexcept
+    {
+        static_assert(sizeof(a_setting->data) == sizeof(std::uint64_t));
+
+        std::uint64_t raw;
+        std::memcpy(std::addressof(raw), std::addressof(a_setting->data), sizeof(raw));
+        return raw;
+    }
+
+    /// The bytes of RE::Setting::data that a setting of `a_type` uses.
+    inline std::uint64_t MaskOf(RE::Setting::Type a_type) noexcept
+    {
+        switch (a_type) {
+        case RE::Setting::Type::kBool:
+            return 0xFF;
+        case RE::Setting::Type::kString:
+            return ~std::uint64_t{ 0 };
+        default:
+            return 0xFFFFFFFF;
+        }
+    }
+}
+
+void DriftWatch::Expect(RE::Setting* a_setting)
+{
+    const auto mask = MaskOf(a_setting->GetType());
+    const auto value = LoadData(a_setting) & mask;
+
+    auto [it, inserted] = _index.try_emplace(a_setting, static_cast<std::uint32_t>(_settings.size()));
+    if (!inserted) {
+        _expected[it->second] = value;
+        return;
+    }
+
+    _settings.push_back(a_setting);
+    _expected.push_back(value);
+    _masks.push_back(mask);
+}
+
+void DriftWatch::Forget(RE::Setting* a_setting)
+{
+    auto it = _index.find(a_setting);
+    if (it == _index.end()) {
+        return;
+    }
+
+    // Move the last entry into the hole.
+    const auto pos = it->second;
+    const auto last = static_cast<std::uint32_t>(_settings.size() - 1);
+    if (pos != last) {
+        _settings[pos] = _settings[last];
+        _expected[pos] = _expected[last];
+        _masks[pos] = _masks[last];
+        _index[_settings[pos]] = pos;
+    }
+    _settings.pop_back();
+    _expected.pop_back();
+    _masks.pop_back();
+    _index.erase(it);
+}
+
+void DriftWatch::Clear() noexcept
+{
+    _settings.clear();
+    _expected.clear();
+    _masks.clear();
+    _index.clear();
+}
+
+std::vector<RE::Setting*> DriftWatch::Check()
+{
+    const auto count = _settings.size();
+    _live.resize(count);
+
+    // Gather first, so that the comparison runs over flat arrays and vectorizes.
+    for (std::size_t i = 0; i < count; ++i) {
+        _live[i] = LoadData(_settings[i]);
+    }
+
+    std::uint64_t diff = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        diff |= (_live[i] & _masks[i]) ^ _expected[i];
+    }
+
+    std::vector<RE::Setting*> drifted;
+    if (diff == 0) {
+        return drifted;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (((_live[i] & _masks[i]) ^ _expected[i]) != 0) {
+            drifted.push_back(_settings[i]);
+        }
+    }
+    return drifted;
+}
+
+void DriftWatch::Reassert(RE::Setting* a_setting) const
+{
+    auto it = _index.find(a_setting);
+    if (it == _index.end()) {
+        return;
+    }
+
+    // Only the bytes of the setting's type are written back.
+    const auto pos = it->second;
+    const auto raw = (LoadData(a_setting) & ~_masks[pos]) | _expected[pos];
+    std::memcpy(std::addressof(a_setting->data), std::addressof(raw), sizeof(raw));
+}
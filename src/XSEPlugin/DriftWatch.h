@@ -0,0 +1,36 @@
+#pragma once
+
+/// The values the plugin last wrote to each setting, packed into flat arrays so
+/// that all of them are compared against the game in one branch-free pass.
+/// Each value is kept as the raw bytes of RE::Setting::data, with a mask of the
+/// bytes its type uses.
+///
+/// Main thread only, like the settings themselves.
+class DriftWatch
+{
+public:
+    /// Expect `a_setting` to keep the value it has now.
+    void Expect(RE::Setting* a_setting);
+
+    /// Stop watching `a_setting`.
+    void Forget(RE::Setting* a_setting);
+
+    void Clear() noexcept;
+
+    /// Return the settings whose value is no longer the expected one. Does not
+    /// allocate unless something drifted.
+    [[nodiscard]] std::vector<RE::Setting*> Check();
+
+    /// Write the expected value back to `a_setting`.
+    void Reassert(RE::Setting* a_setting) const;
+
+    /// Number of watched settings.
+    [[nodiscard]] std::size_t size() const noexcept { return _settings.size(); }
+
+private:
+    std::vector<RE::Setting*>                       _settings;
+    std::vector<std::uint64_t>                      _expected;
+    std::vector<std::uint64_t>                      _masks;
+    std::vector<std::uint64_t>                      _live;   // Scratch space of Check.
+    std::unordered_map<RE::Setting*, std::uint32_t> _index;  // Setting to its position in the arrays.
+};
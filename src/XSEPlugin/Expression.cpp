@@ -0,0 +1,304 @@
+#include "Expression.h"
+
+#include <XSEPlugin/Util/String.h>
+
+/// Recursive descent over the grammar in Expression.h, emitting code as it goes.
+class Expression::Parser
+{
+public:
+    static constexpr std::size_t kMaxNesting = 64;
+
+    Parser(std::string_view a_source, Expression& a_expression) noexcept :
+        _source(a_source),
+        _expression(a_expression)
+    {}
+
+    [[nodiscard]] bool Parse(std::string& a_error)
+    {
+        if (!ParseSum()) {
+            a_error = std::move(_error);
+            return false;
+        }
+
+        SkipSpace();
+        if (!AtEnd()) {
+            a_error = std::format("unexpected '{}' at column {}", Peek(), _pos + 1);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    [[nodiscard]] bool AtEnd() const noexcept { return _pos >= _source.size(); }
+    [[nodiscard]] char Peek() const noexcept { return _source[_pos]; }
+
+    [[nodiscard]] static constexpr bool IsNameStart(char a_ch) noexcept
+    {
+        return (a_ch >= 'A' && a_ch <= 'Z') || (a_ch >= 'a' && a_ch <= 'z') || a_ch == '_';
+    }
+
+    [[nodiscard]] static constexpr bool IsNameChar(char a_ch) noexcept
+    {
+        // Qualified INI names such as INI.fLightLODStartFade:Display.
+        return IsNameStart(a_ch) || (a_ch >= '0' && a_ch <= '9') || a_ch == '.' || a_ch == ':';
+    }
+
+    void SkipSpace() noexcept
+    {
+        while (!AtEnd() && (Peek() == ' ' || Peek() == '\t')) {
+            ++_pos;
+        }
+    }
+
+    [[nodiscard]] bool Consume(char a_ch) noexcept
+    {
+        SkipSpace();
+        if (!AtEnd() && Peek() == a_ch) {
+            ++_pos;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool Fail(std::string_view a_what)
+    {
+        _error = AtEnd() ? std::format("{} at the end", a_what) : std::format("{} at column {}", a_what, _pos + 1);
+        return false;
+    }
+
+    /// Emit an instruction, and track how deep the stack gets.
+    [[nodiscard]] bool Emit(OpCode a_code, std::uint32_t a_operand = 0)
+    {
+        switch (a_code) {
+        case OpCode::kConstant:
+        case OpCode::kBase:
+        case OpCode::kReference:
+            if (++_depth > kMaxDepth) {
+                return Fail("expression is nested too deeply"sv);
+            }
+            break;
+        case OpCode::kNegate:
+        case OpCode::kAbs:
+            break;
+        default:
+            --_depth;
+            break;
+        }
+
+        _expression._code.push_back({ a_code, a_operand });
+        return true;
+    }
+
+    [[nodiscard]] bool ParseSum()
+    {
+        if (!ParseProduct()) {
+            return false;
+        }
+
+        while (true) {
+            if (Consume('+')) {
+                if (!ParseProduct() || !Emit(OpCode::kAdd)) {
+                    return false;
+                }
+            } else if (Consume('-')) {
+                if (!ParseProduct() || !Emit(OpCode::kSubtract)) {
+                    return false;
+                }
+            } else {
+                return true;
+            }
+        }
+    }
+
+    [[nodiscard]] bool ParseProduct()
+    {
+        if (!ParseUnary()) {
+            return false;
+        }
+
+        while (true) {
+            if (Consume('*')) {
+                if (!ParseUnary() || !Emit(OpCode::kMultiply)) {
+                    return false;
+                }
+            } else if (Consume('/')) {
+                if (!ParseUnary() || !Emit(OpCode::kDivide)) {
+                    return false;
+                }
+            } else {
+                return true;
+            }
+        }
+    }
+
+    [[nodiscard]] bool ParseUnary()
+    {
+        // Every level of parentheses or signs passes through here.
+        if (++_nesting > kMaxNesting) {
+            return Fail("expression is nested too deeply"sv);
+        }
+
+        const auto result = Consume('-') ? ParseUnary() && Emit(OpCode::kNegate) : ParseAtom();
+        --_nesting;
+        return result;
+    }
+
+    [[nodiscard]] bool ParseAtom()
+    {
+        SkipSpace();
+        if (AtEnd()) {
+            return Fail("expected a value"sv);
+        }
+
+        if (Consume('(')) {
+            return ParseSum() && (Consume(')') || Fail("expected ')'"sv));
+        }
+
+        if (IsNameStart(Peek())) {
+            const auto start = _pos;
+            while (!AtEnd() && IsNameChar(Peek())) {
+                ++_pos;
+            }
+            const auto name = _source.substr(start, _pos - start);
+
+            SkipSpace();
+            if (!AtEnd() && Peek() == '(') {
+                return ParseCall(name);
+            }
+            if (name == "base"sv) {
+                return Emit(OpCode::kBase);
+            }
+            return Emit(OpCode::kReference, AddReference(name));
+        }
+
+        // Numbers are unsigned here; a sign is a unary operator.
+        double value = 0.0;
+        const auto first = _source.data() + _pos;
+        const auto last = _source.data() + _source.size();
+        auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc{} || *first == '-' || *first == '+') {
+            return Fail("expected a value"sv);
+        }
+        _pos += static_cast<std::size_t>(ptr - first);
+
+        _expression._constants.push_back(value);
+        return Emit(OpCode::kConstant, static_cast<std::uint32_t>(_expression._constants.size() - 1));
+    }
+
+    [[nodiscard]] bool ParseCall(std::string_view a_name)
+    {
+        const bool isAbs = a_name == "abs"sv;
+        const bool isMin = a_name == "min"sv;
+        const bool isMax = a_name == "max"sv;
+        const bool isClamp = a_name == "clamp"sv;
+        if (!isAbs && !isMin && !isMax && !isClamp) {
+            return Fail(std::format("unknown function '{}'", a_name));
+        }
+
+        static_cast<void>(Consume('('));
+
+        // Arguments are folded as they come; clamp(x, lo, hi) is min(max(x, lo), hi).
+        std::size_t args = 0;
+        do {
+            if (!ParseSum()) {
+                return false;
+            }
+            if (++args == 1) {
+                continue;
+            }
+            if (isAbs || (isClamp && args > 3)) {
+                return Fail(std::format("too many arguments to '{}'", a_name));
+            }
+            if (!Emit(isMax || (isClamp && args == 2) ? OpCode::kMax : OpCode::kMin)) {
+                return false;
+            }
+        } while (Consume(','));
+
+        if (!Consume(')')) {
+            return Fail("expected ')'"sv);
+        }
+        if ((isClamp && args != 3) || ((isMin || isMax) && args < 2)) {
+            return Fail(std::format("too few arguments to '{}'", a_name));
+        }
+        return !isAbs || Emit(OpCode::kAbs);
+    }
+
+    [[nodiscard]] std::uint32_t AddReference(std::string_view a_name)
+    {
+        auto& references = _expression._references;
+        auto  it = std::ranges::find_if(references,
+            [&](const std::string& a_reference) { return CaseInsensitiveEqual{}(a_reference, a_name); });
+        if (it == references.end()) {
+            it = references.emplace(references.end(), a_name);
+        }
+        return static_cast<std::uint32_t>(it - references.begin());
+    }
+
+    std::string_view _source;
+    Expression&      _expression;
+    std::string      _error;
+    std::size_t      _pos{ 0 };
+    std::size_t      _depth{ 0 };    // Of the stack of the code emitted so far.
+    std::size_t      _nesting{ 0 };  // Of the parser itself.
+};
+
+std::shared_ptr<const Expression> Expression::Compile(std::string_view a_source, std::string& a_error)
+{
+    auto expression = std::make_shared<Expression>();
+    expression->_source = a_source;
+    if (!Parser{ a_source, *expression }.Parse(a_error)) {
+        return nullptr;
+    }
+    return expression;
+}
+
+double Expression::Evaluate(double a_base, std::span<const double> a_references) const noexcept
+{
+    std::array<double, kMaxDepth> stack;
+    std::size_t                   top = 0;
+
+    for (const auto& [code, operand] : _code) {
+        switch (code) {
+        case OpCode::kConstant:
+            stack[top++] = _constants[operand];
+            break;
+        case OpCode::kBase:
+            stack[top++] = a_base;
+            break;
+        case OpCode::kReference:
+            stack[top++] = a_references[operand];
+            break;
+        case OpCode::kNegate:
+            stack[top - 1] = -stack[top - 1];
+            break;
+        case OpCode::kAbs:
+            stack[top - 1] = std::abs(stack[top - 1]);
+            break;
+        case OpCode::kAdd:
+            --top;
+            stack[top - 1] += stack[top];
+            break;
+        case OpCode::kSubtract:
+            --top;
+            stack[top - 1] -= stack[top];
+            break;
+        case OpCode::kMultiply:
+            --top;
+            stack[top - 1] *= stack[top];
+            break;
+        case OpCode::kDivide:
+            --top;
+            stack[top - 1] /= stack[top];
+            break;
+        case OpCode::kMin:
+            --top;
+            stack[top - 1] = std::min(stack[top - 1], stack[top]);
+            break;
+        case OpCode::kMax:
+            --top;
+            stack[top - 1] = std::max(stack[top - 1], stack[top]);
+            break;
+        }
+    }
+    return top == 1 ? stack[0] : std::numeric_limits<double>::quiet_NaN();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+/// An arithmetic override value, such as "base * 1.25" or "min(base, 300)",
+/// compiled to code for a small stack machine. `base` is the value the setting
+/// had before the plugin wrote it; any other name is the current value of that
+/// setting, qualified as in override tables.
+///
+///     expr  := term (('+' | '-') term)*
+///     term  := unary (('*' | '/') unary)*
+///     unary := '-' unary | atom
+///     atom  := number | 'base' | name | func '(' expr (',' expr)* ')' | '(' expr ')'
+///     func  := 'min' | 'max' | 'clamp' | 'abs'
+class Expression
+{
+public:
+    static constexpr std::size_t kMaxDepth = 16;
+
+    /// Compile `a_source`. On error, return null and describe the error in
+    /// `a_error`. Safe to call from any thread.
+    [[nodiscard]] static std::shared_ptr<const Expression> Compile(std::string_view a_source, std::string& a_error);
+
+    /// Run the code. `a_references` holds the value of each name in references().
+    [[nodiscard]] double Evaluate(double a_base, std::span<const double> a_references) const noexcept;
+
+    [[nodiscard]] const std::string& source() const noexcept { return _source; }
+
+    /// Names of the settings the expression reads, each once, in order of first use.
+    [[nodiscard]] std::span<const std::string> references() const noexcept { return _references; }
+
+private:
+    class Parser;
+
+    enum class OpCode : std::uint8_t
+    {
+        kConstant,   // Push a constant.
+        kBase,       // Push the original value.
+        kReference,  // Push the value of a reference.
+        kNegate,
+        kAdd,
+        kSubtract,
+        kMultiply,
+        kDivide,
+        kMin,
+        kMax,
+        kAbs,
+    };
+
+    struct Instruction
+    {
+        OpCode        code;
+        std::uint32_t operand;  // Index of the constant or reference.
+    };
+
+    std::string              _source;
+    std::vector<Instruction> _code;
+    std::vector<double>      _constants;
+    std::vector<std::string> _references;
+};
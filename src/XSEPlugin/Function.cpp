@@ -1,27 +1,65 @@
 #include "Function.h"
 
-#include <spdlog/sinks/ostream_sink.h>
-
+#include <XSEPlugin/Diagnostics.h>
 #include <XSEPlugin/GameSettings.h>
+#include <XSEPlugin/ReloadQueue.h>
+#include <XSEPlugin/SettingDump.h>
 
-MFMAPI void ReloadConfig(char* a_msg, std::size_t a_len)
+namespace
 {
-    std::ostringstream oss;
+    /// Run `a_func`, and copy what it logged to the message buffer of MFM.
+    template <class Func>
+    inline void RunCaptured(char* a_msg, std::size_t a_len, Func a_func)
     {
-        auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(oss);
-        sink->set_pattern("[%l] %v");
-        spdlog::default_logger_raw()->sinks().push_back(std::move(sink));
-    }
+        // MFM calls functions on the main thread, one at a time.
+        static Diagnostics::Buffer buffer;
 
-    try {
-        GameSettings::Load(false);
-    } catch (...) {
-        // Suppress exception.
+        {
+            Diagnostics::Capture capture{ buffer };
+            try {
+                a_func();
+            } catch (...) {
+                // Suppress exception.
+            }
+        }
+
+        buffer.CopyTo(a_msg, a_len, Diagnostics::kTruncated);
     }
+}
 
-    if (a_msg) {
-        auto msg = oss.str();
-        std::memcpy(a_msg, msg.c_str(), std::min(msg.size() + 1, a_len));
-        spdlog::default_logger_raw()->sinks().pop_back();
+MFMAPI void ReloadConfig(char* a_msg, std::size_t a_len)
+{
+    // The files are read in the background; ReloadStatus tells when they are applied.
+    const auto ticket = ReloadQueue::GetSingleton()->Request();
+    if (a_msg && a_len != 0) {
+        auto result = std::format_to_n(a_msg, static_cast<std::ptrdiff_t>(a_len - 1), "Reload #{} requested.", ticket);
+        *result.out = '\0';
     }
 }
+
+MFMAPI void ReloadStatus(char* a_msg, std::size_t a_len)
+{
+    ReloadQueue::GetSingleton()->WriteStatus(a_msg, a_len);
+}
+
+MFMAPI void RevertAll(char* a_msg, std::size_t a_len)
+{
+    RunCaptured(a_msg, a_len, GameSettings::RevertAll);
+}
+
+MFMAPI void NextProfile(char* a_msg, std::size_t a_len)
+{
+    RunCaptured(a_msg, a_len, GameSettings::NextProfile);
+}
+
+MFMAPI void ShowStats(char* a_msg, std::size_t a_len)
+{
+    RunCaptured(a_msg, a_len, GameSettings::LogStats);
+}
+
+MFMAPI void DumpSettings(char* a_msg, std::size_t a_len)
+{
+    // MFM calls functions on the main thread, one at a time.
+    static SettingDump dump;
+    dump.WritePage(a_msg, a_len);
+}
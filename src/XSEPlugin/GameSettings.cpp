@@ -2,152 +2,488 @@
 
 #include <toml++/toml.hpp>
 
-#include <XSEPlugin/Util/TOML.h>
+#include <XSEPlugin/AppliedLoad.h>
+#include <XSEPlugin/Diagnostics.h>
+#include <XSEPlugin/DriftWatch.h>
+#include <XSEPlugin/LoadStats.h>
+#include <XSEPlugin/OriginalValues.h>
+#include <XSEPlugin/Override.h>
+#include <XSEPlugin/OverrideCache.h>
+#include <XSEPlugin/OverrideTable.h>
+#include <XSEPlugin/PatchProgram.h>
+#include <XSEPlugin/Pipeline.h>
+#include <XSEPlugin/SettingResolver.h>
+#include <XSEPlugin/StringPool.h>
+#include <XSEPlugin/Util/Snapshot.h>
 
 namespace
 {
-    inline RE::Color IntToColor(std::uint32_t a_int) noexcept
+    inline std::optional<std::filesystem::path> GetCachePath()
     {
-        // Unpack integer to (red, green, blue, alpha).
-        return RE::Color{ (a_int >> 24) & 0xFF, (a_int >> 16) & 0xFF, (a_int >> 8) & 0xFF, a_int & 0xFF };
+        auto path = SKSE::log::log_directory();
+        if (path) {
+            *path /= SKSE::PluginDeclaration::GetSingleton()->GetName();
+            *path += L".cache"sv;
+        }
+        return path;
     }
 
-    inline std::vector<std::filesystem::path> ScanDir(const std::filesystem::path& a_root)
+    /// Rethrow the error of a file that failed to load, and report it.
+    [[noreturn]] inline void ReportLoadError(const OverrideFile& a_file, bool a_abort)
     {
-        auto st = std::filesystem::status(a_root);
-
-        if (!std::filesystem::exists(st)) {
-            SKSE::log::warn("\"{}\" does not exist.", PathToStr(a_root));
-            return {};
+        const auto& name = a_file.name;
+        try {
+            std::rethrow_exception(a_file.error);
+        } catch (const toml::parse_error& e) {
+            auto msg = std::format("Failed to load \"{}\" (error occurred at line {}, column {}): {}.", name,
+                e.source().begin.line, e.source().begin.column, e.what());
+            Diagnostics::CaptureOnly(spdlog::level::err, msg);
+            SKSE::stl::report_fatal_error(msg, a_abort);
+        } catch (const std::system_error& e) {
+            auto msg = std::format("Failed to load \"{}\": {}.", name,
+                SKSE::stl::ansi_to_utf8(e.what()).value_or(e.what()));
+            Diagnostics::CaptureOnly(spdlog::level::err, msg);
+            SKSE::stl::report_fatal_error(msg, a_abort);
+        } catch (const std::exception& e) {
+            auto msg = std::format("Failed to load \"{}\": {}.", name, e.what());
+            Diagnostics::CaptureOnly(spdlog::level::err, msg);
+            SKSE::stl::report_fatal_error(msg, a_abort);
         }
+    }
 
-        if (!std::filesystem::is_directory(st)) {
-            SKSE::log::error("\"{}\" is not a directory.", PathToStr(a_root));
-            return {};
+    inline void LogConflicts(const OverrideTable& a_table, std::span<const OverrideFile> a_files)
+    {
+        if (a_table.conflicts() == 0) {
+            return;
         }
 
-        std::vector<std::filesystem::path> paths;
-        paths.reserve(8);
+        const auto details = Diagnostics::ShouldLog(Diagnostics::GetDetailLevel());
+        Diagnostics::Info("{} overrides are shadowed by later files{}", a_table.conflicts(), details ? ":" : ".");
+        if (!details) {
+            return;
+        }
 
-        for (const auto& entry : std::filesystem::directory_iterator{ a_root }) {
-            if (!entry.is_regular_file()) {
+        for (const auto& entry : a_table.entries()) {
+            if (entry.overridden.empty()) {
                 continue;
             }
 
-            if (const auto& path = entry.path(); path.extension().native() == L".toml"sv) {
-                paths.push_back(path);
+            std::string losers;
+            for (auto file : entry.overridden) {
+                losers += std::format("{}\"{}\"", losers.empty() ? "" : ", ", a_files[file].filename());
             }
+            Diagnostics::Detail("'{}' from \"{}\" overrides {}.", entry.name, a_files[entry.file].filename(), losers);
         }
-
-        std::ranges::sort(paths);
-        return paths;
     }
 
-    inline void SetSetting(RE::GameSettingCollection* a_collection, const std::string& a_name, const toml::node& a_node)
+    struct FileChanges
     {
-        auto setting = a_collection->GetSetting(a_name.c_str());
-        if (!setting) {
-            SKSE::log::error("Unknown setting '{}'.", a_name);
-            return;
+        std::size_t added{ 0 };
+        std::size_t removed{ 0 };
+        std::size_t modified{ 0 };
+    };
+
+    /// Compare two file lists by path.
+    inline FileChanges DiffFiles(std::span<const OverrideFile> a_old, std::span<const OverrideFile> a_new)
+    {
+        std::map<std::filesystem::path, const Fingerprint*> old;
+        for (const auto& file : a_old) {
+            old.emplace(file.path, std::addressof(file.fingerprint));
         }
 
-        switch (setting->GetType()) {
-        case RE::Setting::Type::kBool:
-            {
-                if (auto value = a_node.value<bool>()) {
-                    setting->data.b = *value;
-                    SKSE::log::info("Set {} = {}", a_name, *value);
-                } else {
-                    SKSE::log::error("Setting '{}' must be bool.", a_name);
+        FileChanges changes;
+        for (const auto& file : a_new) {
+            if (auto it = old.find(file.path); it == old.end()) {
+                ++changes.added;
+            } else {
+                if (*it->second != file.fingerprint) {
+                    ++changes.modified;
                 }
+                old.erase(it);
             }
-            break;
-        case RE::Setting::Type::kFloat:
-            {
-                if (auto value = a_node.value<float>()) {
-                    setting->data.f = *value;
-                    SKSE::log::info("Set {} = {:.6f}", a_name, *value);
-                } else {
-                    SKSE::log::error("Setting '{}' must be float.", a_name);
-                }
-            }
-            break;
-        case RE::Setting::Type::kSignedInteger:
-            {
-                if (auto value = a_node.value<std::int32_t>()) {
-                    setting->data.i = *value;
-                    SKSE::log::info("Set {} = {}", a_name, *value);
-                } else {
-                    SKSE::log::error("Setting '{}' must be signed integer.", a_name);
-                }
-            }
-            break;
-        case RE::Setting::Type::kColor:
-            {
-                if (auto value = a_node.value<std::uint32_t>()) {
-                    setting->data.r = IntToColor(*value);
-                    SKSE::log::info("Set {} = 0x{:08X}", a_name, *value);
-                } else {
-                    SKSE::log::error("Setting '{}' must be color.", a_name);
-                }
-            }
-            break;
-        case RE::Setting::Type::kString:
-            {
-                if (auto value = a_node.value<std::string>()) {
-                    // NOTE: Does this cause a memory leak?
-                    auto free_str = new std::string{ *std::move(value) };
-                    setting->data.s = free_str->data();
-                    SKSE::log::info("Set {} = {}", a_name, *free_str);
-                } else {
-                    SKSE::log::error("Setting '{}' must be string.", a_name);
-                }
+        }
+        changes.removed = old.size();
+        return changes;
+    }
+
+    [[nodiscard]] inline std::string_view ProfileLabel(std::string_view a_name) noexcept
+    {
+        return a_name.empty() ? "(none)"sv : a_name;
+    }
+
+    /// What was applied by the last load, so a reload only redoes what changed.
+    class LoadState
+    {
+    public:
+        using Applied = std::shared_ptr<const AppliedLoad>;
+
+        /// Safe to call from any thread, and never waits for a load in progress.
+        [[nodiscard]] Applied GetApplied() const noexcept { return _applied.Load(); }
+
+        void SetApplied(Applied a_applied) noexcept { _applied.Publish(std::move(a_applied)); }
+
+        /// Safe to call from any thread.
+        [[nodiscard]] LoadStats GetStats() const
+        {
+            std::scoped_lock lock{ _statsLock };
+            return _stats;
+        }
+
+        void SetStats(LoadStats a_stats)
+        {
+            std::scoped_lock lock{ _statsLock };
+            _stats = std::move(a_stats);
+        }
+
+        StringPool     strings;    // Values of string settings. Main thread only.
+        OriginalValues originals;  // Values from before the first override. Main thread only.
+        DriftWatch     watch;      // Values the overrides are expected to keep. Main thread only.
+
+    private:
+        Snapshot<AppliedLoad> _applied;
+        mutable std::mutex    _statsLock;
+        LoadStats             _stats;  // Of the last load that was committed or failed.
+    };
+
+    inline LoadState& GetLoadState()
+    {
+        static LoadState state;
+        return state;
+    }
+
+    inline void SaveCache(const std::filesystem::path& a_path, std::span<const OverrideFile> a_files)
+    {
+        // Loads may be prepared on several threads at once.
+        static std::mutex saveLock;
+
+        try {
+            std::scoped_lock lock{ saveLock };
+            OverrideCache::Save(a_path, a_files);
+        } catch (const std::exception& e) {
+            Diagnostics::Warn("Failed to save override cache: {}.",
+                SKSE::stl::ansi_to_utf8(e.what()).value_or(e.what()));
+        }
+    }
+}
+
+struct GameSettings::PreparedLoad
+{
+    std::shared_ptr<LoadedFiles>       loaded;        // Unless a file is broken.
+    std::optional<OverrideFile>        error;         // The first broken file.
+    std::size_t                        profile{ 0 };  // Index into `loaded->profiles`.
+    PatchProgram                       program;       // Writes that take the game from `base` to the profile.
+    std::shared_ptr<const AppliedLoad> base;          // The load in effect when this one was prepared.
+    bool                               reload{ false };
+    LoadStats                          stats;
+};
+
+namespace
+{
+    /// Read all override files, then merge them, and for a reload compile them,
+    /// without writing to the game. Files found in `a_cache` are not parsed again.
+    inline std::shared_ptr<GameSettings::PreparedLoad> Prepare(OverrideCache& a_cache,
+        std::shared_ptr<const AppliedLoad> a_base, std::string_view a_profile, bool a_reload)
+    {
+        const LoadStats::Timer total;
+
+        auto load = std::make_shared<GameSettings::PreparedLoad>();
+        load->base = std::move(a_base);
+        load->reload = a_reload;
+
+        auto& stats = load->stats;
+        stats.reload = a_reload;
+
+        // Profiles are read along with the shared files, so switching never touches the disk.
+        const LoadStats::Timer scan;
+        auto paths = Pipeline::ScanDir(GameSettings::root);
+        auto dirs = Pipeline::ScanProfiles(GameSettings::root);
+        auto shared = paths.size();
+        for (auto& dir : dirs) {
+            paths.insert(paths.end(), std::make_move_iterator(dir.paths.begin()),
+                std::make_move_iterator(dir.paths.end()));
+        }
+        stats.scan = scan.Stop();
+
+        auto files = Pipeline::ReadOverrideFiles(std::move(paths), a_cache, stats);
+        auto hits = static_cast<std::size_t>(std::ranges::count(stats.files, true, &LoadStats::File::cached));
+        Diagnostics::Info("{} of {} files were unchanged and not parsed.", hits, files.size());
+
+        // Only rewrite the cache when something was parsed or a file went away.
+        if (auto cachePath = GetCachePath(); cachePath && (hits != files.size() || hits != a_cache.size())) {
+            SaveCache(*cachePath, files);
+        }
+
+        // One broken file rejects the whole load, so the game never sees half of it.
+        auto failed = std::ranges::find_if(files, [](const auto& a_file) { return a_file.error != nullptr; });
+        if (failed != files.end()) {
+            load->error = std::move(*failed);
+            stats.total = total.Stop();
+            return load;
+        }
+
+        for (const auto& file : files) {
+            Diagnostics::Info("\"{}\" has {} overrides.", file.name, file.overrides.size());
+        }
+
+        // Later files win, so each setting is looked up and written only once.
+        // Each profile starts from the shared table and adds its own files.
+        const LoadStats::Timer merge;
+        auto                   loaded = std::make_shared<LoadedFiles>();
+        auto&                  profiles = loaded->profiles;
+        profiles.emplace_back(std::string{}, OverrideTable::Merge(std::span{ files }.first(shared)));
+
+        auto first = static_cast<std::uint32_t>(shared);
+        for (auto& dir : dirs) {
+            const auto count = static_cast<std::uint32_t>(dir.paths.size());
+            profiles.emplace_back(std::move(dir.name),
+                profiles.front().table.Extend(std::span{ files }.subspan(first, count), first));
+            first += count;
+        }
+        loaded->files = std::move(files);
+        stats.merge = merge.Stop();
+
+        load->profile = 0;
+        if (!a_profile.empty()) {
+            auto it = std::ranges::find(profiles, a_profile, &Profile::name);
+            if (it != profiles.end()) {
+                load->profile = static_cast<std::size_t>(it - profiles.begin());
+            } else {
+                Diagnostics::Warn("Profile '{}' does not exist; only the shared files are applied.", a_profile);
             }
-            break;
-        case RE::Setting::Type::kUnsignedInteger:
-            {
-                if (auto value = a_node.value<std::uint32_t>()) {
-                    setting->data.u = *value;
-                    SKSE::log::info("Set {} = {}", a_name, *value);
-                } else {
-                    SKSE::log::error("Setting '{}' must be unsigned integer.", a_name);
-                }
+        }
+
+        const auto& table = profiles[load->profile].table;
+        if (load->profile != 0) {
+            Diagnostics::Info("Profile: {}", profiles[load->profile].name);
+        }
+        LogConflicts(table, loaded->files);
+
+        // Values are converted and type-checked by setting name alone.
+        const LoadStats::Timer compile;
+        load->program = PatchProgram::Compile(table, &load->base->table());
+        stats.compile = compile.Stop();
+
+        // The collection does not change after data is loaded, so a reload can
+        // look up settings here. The first load may be prepared before that,
+        // and is resolved when it is committed.
+        if (a_reload) {
+            const LoadStats::Timer resolve;
+            load->program.Resolve(*SettingResolver::GetSingleton());
+            stats.resolve = resolve.Stop();
+        }
+
+        load->loaded = std::move(loaded);
+        stats.total = total.Stop();
+        return load;
+    }
+
+    /// Write `a_program` to the game, and log what was written. Main thread only.
+    inline void Apply(const PatchProgram& a_program)
+    {
+        auto& state = GetLoadState();
+
+        Diagnostics::Info(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>");
+        a_program.Commit(state.strings, state.originals);
+        a_program.Log();
+        Diagnostics::Info("<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<");
+
+        // Restored settings are no longer ours to keep.
+        for (auto setting : a_program.reverts()) {
+            state.watch.Forget(setting);
+        }
+        for (const auto& op : a_program.ops()) {
+            if (op.setting) {
+                state.watch.Expect(op.setting);
             }
-            break;
-        default:
-            SKSE::log::error("Unknown data type for setting '{}'.", a_name);
-            break;
+        }
+
+        // Nothing points to the replaced strings any more.
+        if (auto freed = state.strings.Collect()) {
+            Diagnostics::Debug("Freed {} string values; {} remain.", freed, state.strings.size());
         }
     }
 
-    inline void LoadFile(const std::filesystem::path& a_path, RE::GameSettingCollection* a_collection)
+    /// Write the prepared program to the game, if the load has no error. Main thread only.
+    inline void Commit(GameSettings::PreparedLoad& a_load, bool a_abort)
     {
-        for (auto data = LoadTOMLFile(a_path); auto& [key, value] : data) {
-            SetSetting(a_collection, std::string{ key.str() }, value);
+        const LoadStats::Timer total;
+        auto&                  stats = a_load.stats;
+
+        if (a_load.error) {
+            stats.failed = true;
+            GetLoadState().SetStats(std::move(stats));
+            Diagnostics::Warn("No setting was changed, because \"{}\" failed to load.",
+                a_load.error->filename());
+            ReportLoadError(*a_load.error, a_abort);
+        }
+
+        auto& state = GetLoadState();
+        auto  current = state.GetApplied();
+        if (current != a_load.base) {
+            // Another load or profile switch was committed since this one was
+            // prepared. A reload stays on the profile that is in effect now.
+            if (auto profile = current->GetProfile(); a_load.reload && profile) {
+                const auto& profiles = a_load.loaded->profiles;
+                if (auto it = std::ranges::find(profiles, profile->name, &Profile::name); it != profiles.end()) {
+                    a_load.profile = static_cast<std::size_t>(it - profiles.begin());
+                }
+            }
+            const LoadStats::Timer compile;
+            a_load.program = PatchProgram::Compile(a_load.loaded->profiles[a_load.profile].table, &current->table());
+            stats.compile += compile.Stop();
+        }
+
+        const auto& program = a_load.program;
+        if (!program.resolved()) {
+            const LoadStats::Timer resolve;
+            a_load.program.Resolve(*SettingResolver::GetSingleton());
+            stats.resolve += resolve.Stop();
+        }
+
+        const LoadStats::Timer apply;
+        Apply(program);
+        stats.apply = apply.Stop();
+
+        if (a_load.reload) {
+            auto changes = DiffFiles(current->loaded->files, a_load.loaded->files);
+            Diagnostics::Info("Files: {} added, {} removed, {} modified.", changes.added, changes.removed,
+                changes.modified);
+        }
+        // At summary verbosity this stands in for the settings themselves.
+        if (a_load.reload || Diagnostics::IsSummary()) {
+            Diagnostics::Info("Settings: {} written, {} unchanged, {} restored.", program.ops().size(),
+                program.unchanged(), program.dropped());
         }
+
+        state.SetApplied(std::make_shared<const AppliedLoad>(std::move(a_load.loaded), a_load.profile, true));
+
+        stats.written = program.ops().size();
+        stats.unchanged = program.unchanged();
+        stats.restored = program.dropped();
+        stats.rejected = program.rejected();
+        stats.total += total.Stop();
+        state.SetStats(std::move(stats));
     }
 }
 
-void GameSettings::Load(bool a_abort)
+void GameSettings::Load(bool a_abort, std::string_view a_profile)
 {
-    for (auto collection = RE::GameSettingCollection::GetSingleton(); const auto& path : ScanDir(root)) {
-        try {
-            SKSE::log::info(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>");
-            SKSE::log::info("\"{}\" is loading...", PathToStr(path));
-            LoadFile(path, collection);
-            SKSE::log::info("\"{}\" has finished loading.", PathToStr(path));
-            SKSE::log::info("<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<");
-        } catch (const toml::parse_error& e) {
-            auto msg = std::format("Failed to load \"{}\" (error occurred at line {}, column {}): {}.", PathToStr(path),
-                e.source().begin.line, e.source().begin.column, e.what());
-            SKSE::stl::report_fatal_error(msg, a_abort);
-        } catch (const std::system_error& e) {
-            auto msg = std::format("Failed to load \"{}\": {}.", PathToStr(path),
-                SKSE::stl::ansi_to_utf8(e.what()).value_or(e.what()));
-            SKSE::stl::report_fatal_error(msg, a_abort);
-        } catch (const std::exception& e) {
-            auto msg = std::format("Failed to load \"{}\": {}.", PathToStr(path), e.what());
-            SKSE::stl::report_fatal_error(msg, a_abort);
+    CommitLoad(PrepareLoad(a_profile), a_abort);
+}
+
+std::shared_ptr<GameSettings::PreparedLoad> GameSettings::PrepareLoad(std::string_view a_profile)
+{
+    auto cachePath = GetCachePath();
+    auto cache = cachePath ? OverrideCache::Open(*cachePath) : OverrideCache{};
+    return Prepare(cache, GetLoadState().GetApplied(), a_profile, false);
+}
+
+void GameSettings::CommitLoad(std::shared_ptr<PreparedLoad> a_load, bool a_abort)
+{
+    Commit(*a_load, a_abort);
+}
+
+void GameSettings::Reload()
+{
+    CommitReload(PrepareReload());
+}
+
+std::shared_ptr<GameSettings::PreparedLoad> GameSettings::PrepareReload()
+{
+    auto base = GetLoadState().GetApplied();
+
+    // Unchanged files take their overrides from the last load instead of disk.
+    auto cache = OverrideCache::FromFiles(base->loaded->files);
+
+    // Stay on the same profile.
+    auto profile = base->GetProfile();
+    auto name = profile ? profile->name : std::string{};
+    return Prepare(cache, std::move(base), name, true);
+}
+
+void GameSettings::CommitReload(std::shared_ptr<PreparedLoad> a_load)
+{
+    Commit(*a_load, false);
+}
+
+void GameSettings::RevertAll()
+{
+    auto& state = GetLoadState();
+    auto  count = state.originals.RestoreAll(state.strings);
+    state.strings.Collect();
+    state.watch.Clear();
+
+    // Keep the files, so the next reload writes every override again without parsing.
+    auto current = state.GetApplied();
+    state.SetApplied(std::make_shared<const AppliedLoad>(current->loaded, current->profile, false));
+
+    Diagnostics::Info("Restored {} settings to their original values.", count);
+}
+
+void GameSettings::SwitchProfile(std::string_view a_name)
+{
+    auto&       state = GetLoadState();
+    auto        current = state.GetApplied();
+    const auto& profiles = current->loaded->profiles;
+
+    auto it = std::ranges::find(profiles, a_name, &Profile::name);
+    if (it == profiles.end()) {
+        Diagnostics::Error("Profile '{}' does not exist.", a_name);
+        return;
+    }
+
+    // Only what differs between the two profiles is written.
+    auto program = PatchProgram::Compile(it->table, &current->table());
+    program.Resolve(*SettingResolver::GetSingleton());
+    Apply(program);
+    Diagnostics::Info("Profile: {}. Settings: {} written, {} unchanged, {} restored.", ProfileLabel(it->name),
+        program.ops().size(), program.unchanged(), program.dropped());
+
+    auto index = static_cast<std::size_t>(it - profiles.begin());
+    state.SetApplied(std::make_shared<const AppliedLoad>(current->loaded, index, true));
+}
+
+void GameSettings::NextProfile()
+{
+    auto current = GetLoadState().GetApplied();
+    if (const auto& profiles = current->loaded->profiles; !profiles.empty()) {
+        SwitchProfile(profiles[(current->profile + 1) % profiles.size()].name);
+    } else {
+        Diagnostics::Warn("Nothing has been loaded yet.");
+    }
+}
+
+std::shared_ptr<const AppliedLoad> GameSettings::GetApplied() noexcept
+{
+    return GetLoadState().GetApplied();
+}
+
+void GameSettings::LogStats()
+{
+    const auto stats = GetLoadState().GetStats();
+    if (stats.total == LoadStats::Duration::zero()) {
+        Diagnostics::Info("Nothing has been loaded yet.");
+        return;
+    }
+    stats.Log(5);
+}
+
+void GameSettings::CheckDrift(bool a_reassert)
+{
+    auto&                  state = GetLoadState();
+    const LoadStats::Timer check;
+    const auto             drifted = state.watch.Check();
+    const auto             elapsed = check.Stop();
+
+    for (auto setting : drifted) {
+        if (a_reassert) {
+            state.watch.Reassert(setting);
+            Diagnostics::Warn("{} was changed by another mod; set it back.", setting->GetName());
+        } else {
+            Diagnostics::Warn("{} was changed by another mod.", setting->GetName());
         }
     }
+
+    Diagnostics::Debug("Checked {} settings for changes in {:.3f} ms; {} changed.", state.watch.size(),
+        std::chrono::duration<double, std::milli>(elapsed).count(), drifted.size());
 }
@@ -1,9 +1,61 @@
 #pragma once
 
+struct AppliedLoad;
+
 class GameSettings
 {
 public:
-    static void Load(bool a_abort = true);
+    /// Read all override files and apply the shared files, then the files of
+    /// `a_profile` if it is not empty.
+    static void Load(bool a_abort = true, std::string_view a_profile = {});
+
+    /// The result of reading and merging the override files.
+    struct PreparedLoad;
+
+    /// The part of Load that only reads files. It does not need game data, so
+    /// it may run on any thread, before data is loaded.
+    [[nodiscard]] static std::shared_ptr<PreparedLoad> PrepareLoad(std::string_view a_profile = {});
+
+    /// The part of Load that looks up and writes the settings. Main thread only,
+    /// after data is loaded.
+    static void CommitLoad(std::shared_ptr<PreparedLoad> a_load, bool a_abort = true);
+
+    /// Load again, with the same profile, but only parse files that changed
+    /// and only write settings whose value changed since the last load. If any
+    /// file fails to load, no setting is changed. Throws on error.
+    static void Reload();
+
+    /// The part of Reload that does not touch the game. Safe to call from any thread.
+    [[nodiscard]] static std::shared_ptr<PreparedLoad> PrepareReload();
+
+    /// The part of Reload that writes to the game. Main thread only. Throws on error.
+    static void CommitReload(std::shared_ptr<PreparedLoad> a_load);
+
+    /// Restore every setting this plugin has written to its original value.
+    /// Main thread only.
+    static void RevertAll();
+
+    /// Apply the profile `a_name`, or the shared files alone if it is empty,
+    /// writing only what differs from the profile in effect. Nothing is read
+    /// from disk. Main thread only.
+    static void SwitchProfile(std::string_view a_name);
+
+    /// Switch to the next profile by name, wrapping around to no profile.
+    static void NextProfile();
+
+    /// Compare every setting this plugin has written with the value it wrote,
+    /// and log those that another mod has changed since. If `a_reassert`, write
+    /// them back. Main thread only.
+    static void CheckDrift(bool a_reassert);
+
+    /// The overrides in effect, with the files they come from. The snapshot
+    /// never changes; a load that is committed meanwhile publishes a new one.
+    /// Safe to call from any thread, and never waits for a load in progress.
+    [[nodiscard]] static std::shared_ptr<const AppliedLoad> GetApplied() noexcept;
+
+    /// Log the timings and counts of the last load or reload, and the files
+    /// that took longest to read. Safe to call from any thread.
+    static void LogStats();
 
     static inline const std::filesystem::path root{ L"Data/SKSE/Plugins/ccld_GameSettingsOverride/"sv };
 };
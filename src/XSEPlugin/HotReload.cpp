@@ -0,0 +1,52 @@
+#include "HotReload.h"
+
+#include <XSEPlugin/Configuration.h>
+#include <XSEPlugin/DirectoryWatcher.h>
+#include <XSEPlugin/GameSettings.h>
+#include <XSEPlugin/ReloadQueue.h>
+
+namespace
+{
+    inline std::unique_ptr<WatchBackend> MakeBackend(const Configuration::HotReload& a_config)
+    {
+#ifdef _WIN32
+        if (a_config.pollInterval == 0) {
+            return std::make_unique<NativeWatchBackend>(GameSettings::root);
+        }
+#endif
+        auto interval = std::chrono::milliseconds{ a_config.pollInterval ? a_config.pollInterval : 1000 };
+        return std::make_unique<PollingWatchBackend>(GameSettings::root, interval);
+    }
+
+    inline void OnChanged()
+    {
+        SKSE::log::info("Override files changed, reloading...");
+
+        // Merged with any reload already under way, and written on the main thread.
+        ReloadQueue::GetSingleton()->Request();
+    }
+}
+
+void HotReload::Start()
+{
+    static std::unique_ptr<DirectoryWatcher> watcher;
+
+    Configuration::HotReload config;
+    {
+        auto lock = Configuration::LockShared();
+        config = Configuration::GetSingleton()->hotReload;
+    }
+
+    if (!config.enable || watcher) {
+        return;
+    }
+
+    try {
+        watcher = std::make_unique<DirectoryWatcher>(MakeBackend(config), std::chrono::milliseconds{ config.debounce },
+            OnChanged);
+        SKSE::log::info("Watching \"{}\" for changes.", PathToStr(GameSettings::root));
+    } catch (const std::system_error& e) {
+        SKSE::log::error("Failed to watch \"{}\": {}.", PathToStr(GameSettings::root),
+            SKSE::stl::ansi_to_utf8(e.what()).value_or(e.what()));
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/// Reloads the override files in the background whenever they change.
+class HotReload
+{
+public:
+    /// Start watching GameSettings::root, if enabled in the configuration.
+    static void Start();
+};
@@ -0,0 +1,51 @@
+#include "LoadStats.h"
+
+#include <XSEPlugin/Diagnostics.h>
+
+namespace
+{
+    inline double ToMs(LoadStats::Duration a_duration) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(a_duration).count();
+    }
+}
+
+void LoadStats::Log(std::size_t a_slowest) const
+{
+    std::size_t cached = 0;
+    std::size_t overrides = 0;
+    for (const auto& file : files) {
+        cached += file.cached ? 1 : 0;
+        overrides += file.overrides;
+    }
+
+    Diagnostics::Info("Last {}: {:.3f} ms{}", reload ? "reload"sv : "load"sv, ToMs(total),
+        failed ? ", failed; no setting was changed."sv : "."sv);
+    Diagnostics::Info("Files: {} ({} cached), {} overrides.", files.size(), cached, overrides);
+    Diagnostics::Info("Scan {:.3f} ms, read {:.3f} ms, parse {:.3f} ms, merge {:.3f} ms, compile {:.3f} ms, "
+                      "resolve {:.3f} ms, apply {:.3f} ms.",
+        ToMs(scan), ToMs(read), ToMs(parse), ToMs(merge), ToMs(compile), ToMs(resolve), ToMs(apply));
+    Diagnostics::Info("Settings: {} written, {} unchanged, {} restored, {} rejected.", written, unchanged, restored,
+        rejected);
+
+    if (files.empty() || a_slowest == 0) {
+        return;
+    }
+
+    std::vector<const File*> slowest;
+    slowest.reserve(files.size());
+    for (const auto& file : files) {
+        slowest.push_back(std::addressof(file));
+    }
+
+    const auto count = std::min(a_slowest, slowest.size());
+    std::ranges::partial_sort(slowest, slowest.begin() + static_cast<std::ptrdiff_t>(count), std::ranges::greater{},
+        [](const File* a_file) { return a_file->read + a_file->parse; });
+
+    Diagnostics::Info("Slowest files:");
+    for (auto file : std::span{ slowest }.first(count)) {
+        Diagnostics::Info("\"{}\": read {:.3f} ms, parse {:.3f} ms, {} overrides{}.", file->name,
+            ToMs(file->read), ToMs(file->parse), file->overrides,
+            file->failed ? ", failed"sv : (file->cached ? ", cached"sv : ""sv));
+    }
+}
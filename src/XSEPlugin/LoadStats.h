@@ -0,0 +1,56 @@
+#pragma once
+
+/// Where the time of one load went, and what it did to the settings. Cheap
+/// enough to be collected on every load.
+struct LoadStats
+{
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::nanoseconds;
+
+    /// Measures the time from its construction until Stop.
+    class Timer
+    {
+    public:
+        Timer() noexcept :
+            _start(Clock::now())
+        {}
+
+        [[nodiscard]] Duration Stop() const noexcept { return Clock::now() - _start; }
+
+    private:
+        Clock::time_point _start;
+    };
+
+    struct File
+    {
+        std::string name;  // Path as UTF-8.
+        Duration    read{ 0 };   // Mapping and hashing.
+        Duration    parse{ 0 };  // Zero if the overrides came from the cache.
+        std::size_t overrides{ 0 };
+        bool        cached{ false };
+        bool        failed{ false };
+    };
+
+    // Read and parse run on several threads, so their totals add up the time
+    // of each file and may exceed `total`.
+    Duration scan{ 0 };
+    Duration read{ 0 };
+    Duration parse{ 0 };
+    Duration merge{ 0 };
+    Duration compile{ 0 };  // Converting and type-checking the values.
+    Duration resolve{ 0 };  // Looking up the settings.
+    Duration apply{ 0 };
+    Duration total{ 0 };
+
+    std::size_t written{ 0 };
+    std::size_t unchanged{ 0 };
+    std::size_t restored{ 0 };
+    std::size_t rejected{ 0 };  // Unknown settings and values of the wrong type.
+
+    std::vector<File> files;  // In scan order.
+    bool              reload{ false };
+    bool              failed{ false };  // A file failed to load, so no setting was changed.
+
+    /// Log the totals, then the files that took longest.
+    void Log(std::size_t a_slowest) const;
+};
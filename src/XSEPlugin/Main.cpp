@@ -1,6 +1,11 @@
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
+#include <XSEPlugin/Configuration.h>
+#include <XSEPlugin/Diagnostics.h>
 #include <XSEPlugin/GameSettings.h>
+#include <XSEPlugin/HotReload.h>
+#include <XSEPlugin/Watchdog.h>
 #include <XSEPlugin/Util/Win.h>
 
 namespace
@@ -27,11 +32,82 @@ namespace
         spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
     }
 
+    /// Apply the logging options, which are only known once the configuration
+    /// has been read. Must run before any other thread logs.
+    void ConfigureLogger()
+    {
+        Configuration::Logging config;
+        {
+            auto lock = Configuration::LockShared();
+            config = Configuration::GetSingleton()->logging;
+        }
+
+        Diagnostics::SetSummary(config.summary);
+
+        auto logger = spdlog::default_logger();
+        if (config.async) {
+            // The new logger writes to the same file, which stays open.
+            constexpr std::size_t kQueueSize = 8192;
+            spdlog::init_thread_pool(kQueueSize, 1);
+            auto async = std::make_shared<spdlog::async_logger>(logger->name(), logger->sinks().begin(),
+                logger->sinks().end(), spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+            async->set_level(logger->level());
+            async->flush_on(logger->flush_level());
+            logger = std::move(async);
+            spdlog::set_default_logger(logger);
+        }
+
+        if (config.flushInterval > 0) {
+            // Warnings and errors are still flushed at once.
+            logger->flush_on(spdlog::level::warn);
+            spdlog::flush_every(std::chrono::milliseconds{ config.flushInterval });
+        }
+
+        SKSE::log::debug("Logging: {}, {}, flushed {}.", config.async ? "asynchronous" : "synchronous",
+            config.summary ? "summary" : "every setting",
+            config.flushInterval > 0 ? std::format("every {} ms", config.flushInterval) : "always");
+    }
+
+    /// The override files, read in the background from plugin load until data is loaded.
+    inline std::future<std::shared_ptr<GameSettings::PreparedLoad>>& GetPreparedLoad()
+    {
+        static std::future<std::shared_ptr<GameSettings::PreparedLoad>> load;
+        return load;
+    }
+
+    void PrepareLoad()
+    {
+        std::string profile;
+        {
+            auto lock = Configuration::LockShared();
+            profile = Configuration::GetSingleton()->profiles.active;
+        }
+
+        // The files do not depend on game data, so they are read while the game starts.
+        GetPreparedLoad() = std::async(std::launch::async, [profile = std::move(profile)] {
+            return GameSettings::PrepareLoad(profile);
+        });
+    }
+
     void OnMessage(SKSE::MessagingInterface::Message* a_message)
     {
         switch (a_message->type) {
         case SKSE::MessagingInterface::kDataLoaded:
-            GameSettings::Load();
+            {
+                // The files were read in the background; only settings are looked up and written here.
+                const auto start = std::chrono::steady_clock::now();
+                auto       load = GetPreparedLoad().get();
+                SKSE::log::debug("Waited {:.3f} ms for the override files.",
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                GameSettings::CommitLoad(std::move(load));
+                HotReload::Start();
+                Watchdog::Start();
+            }
+            break;
+        case SKSE::MessagingInterface::kPostLoadGame:
+        case SKSE::MessagingInterface::kNewGame:
+            // Other mods often change settings while a game loads.
+            Watchdog::Check();
             break;
         default:
             break;
@@ -58,6 +134,11 @@ SKSEPluginLoad(const SKSE::LoadInterface* a_skse)
 
     SKSE::Init(a_skse);
 
+    Configuration::Init();
+    ConfigureLogger();
+
+    PrepareLoad();
+
     SKSE::GetMessagingInterface()->RegisterListener(OnMessage);
 
     SKSE::log::info("{} has finished loading.", plugin->GetName());
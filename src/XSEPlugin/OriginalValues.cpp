@@ -0,0 +1,106 @@
+#include "OriginalValues.h"
+
+#include <XSEPlugin/StringPool.h>
+
+void OriginalValues::Record(RE::Setting* a_setting)
+{
+    if (_index.contains(a_setting)) {
+        return;
+    }
+
+    const auto    type = a_setting->GetType();
+    std::uint32_t index;
+    switch (type) {
+    case RE::Setting::Type::kBool:
+        index = _bools.Add(a_setting, a_setting->data.b);
+        break;
+    case RE::Setting::Type::kFloat:
+        index = _floats.Add(a_setting, a_setting->data.f);
+        break;
+    case RE::Setting::Type::kSignedInteger:
+        index = _ints.Add(a_setting, a_setting->data.i);
+        break;
+    case RE::Setting::Type::kColor:
+    case RE::Setting::Type::kUnsignedInteger:
+        index = _uints.Add(a_setting, a_setting->data.u);
+        break;
+    case RE::Setting::Type::kString:
+        index = _strings.Add(a_setting, a_setting->data.s);
+        break;
+    default:
+        return;
+    }
+    _index.emplace(a_setting, Slot{ type, index });
+}
+
+bool OriginalValues::Restore(RE::Setting* a_setting, StringPool& a_strings)
+{
+    auto it = _index.find(a_setting);
+    if (it == _index.end()) {
+        return false;
+    }
+
+    const auto [type, index] = it->second;
+    switch (type) {
+    case RE::Setting::Type::kBool:
+        a_setting->data.b = _bools.values[index];
+        break;
+    case RE::Setting::Type::kFloat:
+        a_setting->data.f = _floats.values[index];
+        break;
+    case RE::Setting::Type::kSignedInteger:
+        a_setting->data.i = _ints.values[index];
+        break;
+    case RE::Setting::Type::kString:
+        a_strings.Release(a_setting);
+        a_setting->data.s = _strings.values[index];
+        break;
+    default:
+        a_setting->data.u = _uints.values[index];
+        break;
+    }
+    return true;
+}
+
+std::size_t OriginalValues::RestoreAll(StringPool& a_strings)
+{
+    for (std::size_t i = 0; i < _bools.values.size(); ++i) {
+        _bools.settings[i]->data.b = _bools.values[i];
+    }
+    for (std::size_t i = 0; i < _floats.values.size(); ++i) {
+        _floats.settings[i]->data.f = _floats.values[i];
+    }
+    for (std::size_t i = 0; i < _ints.values.size(); ++i) {
+        _ints.settings[i]->data.i = _ints.values[i];
+    }
+    for (std::size_t i = 0; i < _uints.values.size(); ++i) {
+        _uints.settings[i]->data.u = _uints.values[i];
+    }
+    for (std::size_t i = 0; i < _strings.values.size(); ++i) {
+        a_strings.Release(_strings.settings[i]);
+        _strings.settings[i]->data.s = _strings.values[i];
+    }
+    return _index.size();
+}
+
+std::optional<double> OriginalValues::GetNumber(RE::Setting* a_setting) const
+{
+    auto it = _index.find(a_setting);
+    if (it == _index.end()) {
+        return std::nullopt;
+    }
+
+    const auto [type, index] = it->second;
+    switch (type) {
+    case RE::Setting::Type::kBool:
+        return _bools.values[index] ? 1.0 : 0.0;
+    case RE::Setting::Type::kFloat:
+        return _floats.values[index];
+    case RE::Setting::Type::kSignedInteger:
+        return _ints.values[index];
+    case RE::Setting::Type::kUnsignedInteger:
+        return _uints.values[index];
+    default:
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+class StringPool;
+
+/// The values settings had before the plugin first wrote them. Values are kept
+/// in one array per type, so that restoring them walks a few dense arrays, and
+/// costs nothing for settings that were never touched.
+///
+/// Main thread only, like the settings themselves.
+class OriginalValues
+{
+public:
+    /// Remember the current value of `a_setting`, unless it is already known.
+    void Record(RE::Setting* a_setting);
+
+    /// Write back the value of `a_setting`. Return false if it was never recorded.
+    bool Restore(RE::Setting* a_setting, StringPool& a_strings);
+
+    /// Write back every recorded value. Return how many were restored.
+    std::size_t RestoreAll(StringPool& a_strings);
+
+    /// The recorded value of a bool, float or integer setting, as a number.
+    [[nodiscard]] std::optional<double> GetNumber(RE::Setting* a_setting) const;
+
+    /// Number of recorded settings.
+    [[nodiscard]] std::size_t size() const noexcept { return _index.size(); }
+
+private:
+    template <class T>
+    struct Column
+    {
+        std::vector<RE::Setting*> settings;
+        std::vector<T>            values;
+
+        std::uint32_t Add(RE::Setting* a_setting, T a_value)
+        {
+            settings.push_back(a_setting);
+            values.push_back(a_value);
+            return static_cast<std::uint32_t>(values.size() - 1);
+        }
+    };
+
+    struct Slot
+    {
+        RE::Setting::Type type;
+        std::uint32_t     index;  // Into the column of `type`.
+    };
+
+    Column<bool>                           _bools;
+    Column<float>                          _floats;
+    Column<std::int32_t>                   _ints;
+    Column<std::uint32_t>                  _uints;  // Also colors, as their raw bits.
+    Column<char*>                          _strings;
+    std::unordered_map<RE::Setting*, Slot> _index;
+};
@@ -0,0 +1,366 @@
+#include "Override.h"
+
+#include <toml++/toml.hpp>
+
+#include <XSEPlugin/SettingResolver.h>
+
+namespace
+{
+    /// Scanner for the subset of TOML that override files are made of: bare
+    /// keys set to booleans, decimal or hex integers, floats and single-line
+    /// strings without unicode escapes. It gives up on everything else, and on
+    /// anything it is not sure toml++ would accept, so that the slow path sees
+    /// the file and reports the error.
+    class FlatParser
+    {
+    public:
+        explicit FlatParser(std::string_view a_doc) noexcept : _doc(a_doc) {}
+
+        [[nodiscard]] bool Parse(std::vector<Override>& a_overrides)
+        {
+            if (_doc.starts_with("\xEF\xBB\xBF"sv)) {
+                _pos = 3;
+            }
+
+            while (!AtEnd()) {
+                SkipSpace();
+                if (!AtEnd() && Peek() != '#' && Peek() != '\r' && Peek() != '\n') {
+                    auto& entry = a_overrides.emplace_back();
+                    if (!ParseKey(entry.name) || !Consume('=') || !ParseValue(entry.value)) {
+                        return false;
+                    }
+                }
+                if (!ParseLineEnd()) {
+                    return false;
+                }
+            }
+
+            // toml++ keeps keys sorted, and rejects duplicates.
+            std::ranges::sort(a_overrides, {}, &Override::name);
+            return std::ranges::adjacent_find(a_overrides, {}, &Override::name) == a_overrides.end();
+        }
+
+    private:
+        [[nodiscard]] bool AtEnd() const noexcept { return _pos >= _doc.size(); }
+        [[nodiscard]] char Peek() const noexcept { return _doc[_pos]; }
+
+        [[nodiscard]] static constexpr bool IsDigit(char a_ch) noexcept { return a_ch >= '0' && a_ch <= '9'; }
+
+        [[nodiscard]] static constexpr bool IsHexDigit(char a_ch) noexcept
+        {
+            return IsDigit(a_ch) || (a_ch >= 'A' && a_ch <= 'F') || (a_ch >= 'a' && a_ch <= 'f');
+        }
+
+        [[nodiscard]] static constexpr bool IsBareKeyChar(char a_ch) noexcept
+        {
+            return IsDigit(a_ch) || (a_ch >= 'A' && a_ch <= 'Z') || (a_ch >= 'a' && a_ch <= 'z') || a_ch == '_' ||
+                   a_ch == '-';
+        }
+
+        /// Printable ASCII and tab, which is all that strings and comments may hold here.
+        [[nodiscard]] static constexpr bool IsTextChar(char a_ch) noexcept
+        {
+            return a_ch == '\t' || (a_ch >= 0x20 && a_ch < 0x7F);
+        }
+
+        void SkipSpace() noexcept
+        {
+            while (!AtEnd() && (Peek() == ' ' || Peek() == '\t')) {
+                ++_pos;
+            }
+        }
+
+        [[nodiscard]] bool Consume(char a_ch) noexcept
+        {
+            SkipSpace();
+            if (AtEnd() || Peek() != a_ch) {
+                return false;
+            }
+            ++_pos;
+            SkipSpace();
+            return true;
+        }
+
+        /// Trailing comment and end of line.
+        [[nodiscard]] bool ParseLineEnd() noexcept
+        {
+            SkipSpace();
+            if (!AtEnd() && Peek() == '#') {
+                while (!AtEnd() && Peek() != '\r' && Peek() != '\n') {
+                    if (!IsTextChar(Peek())) {
+                        return false;
+                    }
+                    ++_pos;
+                }
+            }
+            if (AtEnd()) {
+                return true;
+            }
+            if (Peek() == '\r') {
+                ++_pos;
+                if (AtEnd()) {
+                    return false;
+                }
+            }
+            if (Peek() != '\n') {
+                return false;
+            }
+            ++_pos;
+            return true;
+        }
+
+        [[nodiscard]] bool ParseKey(std::string& a_key)
+        {
+            const auto start = _pos;
+            while (!AtEnd() && IsBareKeyChar(Peek())) {
+                ++_pos;
+            }
+            a_key.assign(_doc.substr(start, _pos - start));
+            return !a_key.empty();
+        }
+
+        [[nodiscard]] bool ParseValue(OverrideValue& a_value)
+        {
+            if (AtEnd()) {
+                return false;
+            }
+
+            const auto rest = _doc.substr(_pos);
+            if (rest.starts_with("true"sv)) {
+                _pos += 4;
+                a_value = true;
+                return true;
+            }
+            if (rest.starts_with("false"sv)) {
+                _pos += 5;
+                a_value = false;
+                return true;
+            }
+            if (rest.starts_with("0x"sv)) {
+                return ParseHex(a_value);
+            }
+            if (Peek() == '"' || Peek() == '\'') {
+                return ParseString(a_value);
+            }
+            return ParseNumber(a_value);
+        }
+
+        /// Hex integers, which is how colors are written.
+        [[nodiscard]] bool ParseHex(OverrideValue& a_value) noexcept
+        {
+            _pos += 2;
+            const auto start = _pos;
+            while (!AtEnd() && IsHexDigit(Peek())) {
+                ++_pos;
+            }
+
+            std::int64_t value = 0;
+            const auto   last = _doc.data() + _pos;
+            const auto [ptr, ec] = std::from_chars(_doc.data() + start, last, value, 16);
+            if (ec != std::errc{} || ptr != last) {
+                return false;
+            }
+            a_value = value;
+            return true;
+        }
+
+        /// Decimal integers and floats, without underscores, inf or nan.
+        [[nodiscard]] bool ParseNumber(OverrideValue& a_value) noexcept
+        {
+            const auto start = _pos;
+            if (Peek() == '+' || Peek() == '-') {
+                ++_pos;
+            }
+
+            // No leading zeros.
+            const auto digits = _pos;
+            if (!SkipDigits() || (_pos - digits > 1 && _doc[digits] == '0')) {
+                return false;
+            }
+
+            bool isFloat = false;
+            if (!AtEnd() && Peek() == '.') {
+                ++_pos;
+                if (!SkipDigits()) {
+                    return false;
+                }
+                isFloat = true;
+            }
+            if (!AtEnd() && (Peek() == 'e' || Peek() == 'E')) {
+                ++_pos;
+                if (!AtEnd() && (Peek() == '+' || Peek() == '-')) {
+                    ++_pos;
+                }
+                if (!SkipDigits()) {
+                    return false;
+                }
+                isFloat = true;
+            }
+
+            // from_chars does not take a plus sign.
+            const auto first = _doc.data() + (_doc[start] == '+' ? start + 1 : start);
+            const auto last = _doc.data() + _pos;
+            if (isFloat) {
+                return FromChars<double>(first, last, a_value);
+            }
+            return FromChars<std::int64_t>(first, last, a_value);
+        }
+
+        template <class T>
+        [[nodiscard]] static bool FromChars(const char* a_first, const char* a_last, OverrideValue& a_value) noexcept
+        {
+            T value{};
+            const auto [ptr, ec] = std::from_chars(a_first, a_last, value);
+            if (ec != std::errc{} || ptr != a_last) {
+                return false;
+            }
+            a_value = value;
+            return true;
+        }
+
+        [[nodiscard]] bool SkipDigits() noexcept
+        {
+            const auto start = _pos;
+            while (!AtEnd() && IsDigit(Peek())) {
+                ++_pos;
+            }
+            return _pos != start;
+        }
+
+        /// Single-line basic and literal strings.
+        [[nodiscard]] bool ParseString(OverrideValue& a_value)
+        {
+            const auto quote = Peek();
+            if (_doc.substr(_pos).starts_with(quote == '"' ? R"(""")"sv : R"(''')"sv)) {
+                return false;
+            }
+            ++_pos;
+
+            std::string value;
+            while (!AtEnd() && Peek() != quote) {
+                auto ch = Peek();
+                if (!IsTextChar(ch)) {
+                    return false;
+                }
+                ++_pos;
+
+                if (ch == '\\' && quote == '"') {
+                    if (AtEnd()) {
+                        return false;
+                    }
+                    switch (Peek()) {
+                    case 'b':
+                        ch = '\b';
+                        break;
+                    case 't':
+                        ch = '\t';
+                        break;
+                    case 'n':
+                        ch = '\n';
+                        break;
+                    case 'f':
+                        ch = '\f';
+                        break;
+                    case 'r':
+                        ch = '\r';
+                        break;
+                    case '"':
+                    case '\\':
+                        ch = Peek();
+                        break;
+                    default:
+                        return false;
+                    }
+                    ++_pos;
+                }
+                value += ch;
+            }
+            if (AtEnd()) {
+                return false;
+            }
+            ++_pos;
+
+            a_value = std::move(value);
+            return true;
+        }
+
+        std::string_view _doc;
+        std::size_t      _pos{ 0 };
+    };
+
+    inline OverrideValue ToOverrideValue(const toml::node& a_node)
+    {
+        switch (a_node.type()) {
+        case toml::node_type::boolean:
+            return a_node.as_boolean()->get();
+        case toml::node_type::integer:
+            return a_node.as_integer()->get();
+        case toml::node_type::floating_point:
+            return a_node.as_floating_point()->get();
+        case toml::node_type::string:
+            return a_node.as_string()->get();
+        default:
+            return std::monostate{};
+        }
+    }
+}
+
+std::vector<Override> ParseOverrides(std::string_view a_doc, std::string_view a_source)
+{
+    if (std::vector<Override> overrides; FlatParser{ a_doc }.Parse(overrides)) {
+        return overrides;
+    }
+
+    auto data = toml::parse(a_doc, a_source);
+
+    std::vector<Override>            overrides;
+    std::vector<toml::source_region> sources;
+    overrides.reserve(data.size());
+    sources.reserve(data.size());
+    const auto add = [&](std::string a_name, const toml::node& a_node) {
+        overrides.emplace_back(std::move(a_name), ToOverrideValue(a_node));
+        sources.push_back(a_node.source());
+    };
+
+    for (auto& [key, value] : data) {
+        auto collection = CollectionOfSection(key.str());
+        auto section = value.as_table();
+        if (!collection || !section) {
+            add(std::string{ key.str() }, value);
+            continue;
+        }
+
+        // INI settings are named "setting:Section", which can be written as
+        // a quoted key, or as a key of a subtable named after the INI section.
+        for (auto& [name, node] : *section) {
+            if (auto iniSection = node.as_table()) {
+                for (auto& [setting, leaf] : *iniSection) {
+                    add(QualifyName(*collection, std::format("{}:{}", setting.str(), name.str())), leaf);
+                }
+            } else {
+                add(QualifyName(*collection, name.str()), node);
+            }
+        }
+    }
+
+    std::vector<std::size_t> order(overrides.size());
+    std::iota(order.begin(), order.end(), std::size_t{ 0 });
+    const auto nameOf = [&](std::size_t a_index) -> const std::string& { return overrides[a_index].name; };
+    std::ranges::sort(order, {}, nameOf);
+
+    // toml++ only rejects keys that are spelled the same, but both spellings of
+    // an INI setting name the same one. Report the later, as toml++ would.
+    if (auto duplicate = std::ranges::adjacent_find(order, {}, nameOf); duplicate != order.end()) {
+        const auto& first = sources[duplicate[0]];
+        const auto& second = sources[duplicate[1]];
+        const auto  msg = std::format("cannot redefine existing setting '{}'", nameOf(*duplicate));
+        throw toml::parse_error(msg.c_str(), first.begin < second.begin ? second : first);
+    }
+
+    std::vector<Override> sorted;
+    sorted.reserve(overrides.size());
+    for (auto index : order) {
+        sorted.push_back(std::move(overrides[index]));
+    }
+    return sorted;
+}
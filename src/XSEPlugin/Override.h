@@ -0,0 +1,71 @@
+#pragma once
+
+/// The value of an override as written in a file, before it is checked against
+/// the type of the setting. `std::monostate` marks a value the plugin does not
+/// understand (array, table, date, ...).
+using OverrideValue = std::variant<std::monostate, bool, std::int64_t, double, std::string>;
+
+struct Override
+{
+    std::string   name;  // Qualified by its collection, see SettingResolver.h.
+    OverrideValue value;
+};
+
+/// What a file looked like when its overrides were read.
+struct Fingerprint
+{
+    std::uint64_t size{ 0 };
+    std::int64_t  mtime{ 0 };
+    std::uint64_t hash{ 0 };
+
+    friend bool operator==(const Fingerprint&, const Fingerprint&) = default;
+};
+
+/// All overrides of one file, sorted by name.
+struct OverrideFile
+{
+    std::filesystem::path path;
+    std::string           name;  // `path` as UTF-8, converted once for every message and the cache.
+    Fingerprint           fingerprint;
+    std::vector<Override> overrides;
+    std::exception_ptr    error;
+
+    /// The file name part of `name`.
+    [[nodiscard]] std::string_view filename() const noexcept
+    {
+        const std::string_view str{ name };
+        return str.substr(str.find_last_of("/\\"sv) + 1);
+    }
+};
+
+/// Parse a TOML document into a flat list of overrides. Top-level keys are game
+/// settings; the [INI] and [INIPrefs] tables hold INI settings.
+[[nodiscard]] std::vector<Override> ParseOverrides(std::string_view a_doc, std::string_view a_source);
+
+/// Convert an override value to the representation of a setting type.
+/// Integers are accepted for floats, but never the other way around.
+template <class T>
+[[nodiscard]] inline std::optional<T> OverrideValueAs(const OverrideValue& a_value) noexcept
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        if (auto value = std::get_if<bool>(&a_value)) {
+            return *value;
+        }
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (auto value = std::get_if<double>(&a_value)) {
+            return static_cast<T>(*value);
+        }
+        if (auto value = std::get_if<std::int64_t>(&a_value)) {
+            return static_cast<T>(*value);
+        }
+    } else if constexpr (std::is_integral_v<T>) {
+        if (auto value = std::get_if<std::int64_t>(&a_value); value && std::in_range<T>(*value)) {
+            return static_cast<T>(*value);
+        }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        if (auto value = std::get_if<std::string>(&a_value)) {
+            return *value;
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,235 @@
+#include "OverrideCache.h"
+
+#include <XSEPlugin/Util/File.h>
+#include <XSEPlugin/Util/Hash.h>
+#include <XSEPlugin/Util/MappedFile.h>
+
+namespace
+{
+    // Bump the version whenever the layout below changes, or what is stored in
+    // it: 2 keys files by their UTF-8 name, and qualifies INI setting names.
+    constexpr std::uint32_t kMagic = 0x434F5347;  // "GSOC"
+    constexpr std::uint32_t kVersion = 2;
+
+    class Writer
+    {
+    public:
+        template <class T>
+            requires(std::is_trivially_copyable_v<T>)
+        void Write(const T& a_value)
+        {
+            _buf.append(reinterpret_cast<const char*>(std::addressof(a_value)), sizeof(T));
+        }
+
+        void Write(std::string_view a_str)
+        {
+            Write(static_cast<std::uint32_t>(a_str.size()));
+            _buf.append(a_str);
+        }
+
+        [[nodiscard]] std::string& buffer() noexcept { return _buf; }
+
+    private:
+        std::string _buf;
+    };
+
+    class Reader
+    {
+    public:
+        explicit Reader(std::string_view a_buf) noexcept : _buf(a_buf) {}
+
+        template <class T>
+            requires(std::is_trivially_copyable_v<T>)
+        [[nodiscard]] bool Read(T& a_value) noexcept
+        {
+            if (_buf.size() < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(std::addressof(a_value), _buf.data(), sizeof(T));
+            _buf.remove_prefix(sizeof(T));
+            return true;
+        }
+
+        [[nodiscard]] bool Read(std::string& a_str)
+        {
+            std::uint32_t size;
+            if (!Read(size) || _buf.size() < size) {
+                return false;
+            }
+            a_str.assign(_buf.data(), size);
+            _buf.remove_prefix(size);
+            return true;
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return _buf.empty(); }
+
+    private:
+        std::string_view _buf;
+    };
+
+    void WriteValue(Writer& a_writer, const OverrideValue& a_value)
+    {
+        a_writer.Write(static_cast<std::uint8_t>(a_value.index()));
+        std::visit(
+            [&]<class T>(const T& a_data) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    a_writer.Write(std::string_view{ a_data });
+                } else if constexpr (!std::is_same_v<T, std::monostate>) {
+                    a_writer.Write(a_data);
+                }
+            },
+            a_value);
+    }
+
+    template <class T>
+    bool ReadAlternative(Reader& a_reader, OverrideValue& a_value)
+    {
+        if constexpr (std::is_same_v<T, std::monostate>) {
+            a_value.emplace<T>();
+            return true;
+        } else {
+            T data{};
+            if (!a_reader.Read(data)) {
+                return false;
+            }
+            a_value.emplace<T>(std::move(data));
+            return true;
+        }
+    }
+
+    bool ReadValue(Reader& a_reader, OverrideValue& a_value)
+    {
+        std::uint8_t index;
+        if (!a_reader.Read(index)) {
+            return false;
+        }
+
+        switch (index) {
+        case 0:
+            return ReadAlternative<std::variant_alternative_t<0, OverrideValue>>(a_reader, a_value);
+        case 1:
+            return ReadAlternative<std::variant_alternative_t<1, OverrideValue>>(a_reader, a_value);
+        case 2:
+            return ReadAlternative<std::variant_alternative_t<2, OverrideValue>>(a_reader, a_value);
+        case 3:
+            return ReadAlternative<std::variant_alternative_t<3, OverrideValue>>(a_reader, a_value);
+        case 4:
+            return ReadAlternative<std::variant_alternative_t<4, OverrideValue>>(a_reader, a_value);
+        default:
+            return false;
+        }
+    }
+    static_assert(std::variant_size_v<OverrideValue> == 5, "Update ReadValue for new alternatives.");
+
+    bool ReadFingerprint(Reader& a_reader, Fingerprint& a_fingerprint) noexcept
+    {
+        return a_reader.Read(a_fingerprint.size) && a_reader.Read(a_fingerprint.mtime) &&
+               a_reader.Read(a_fingerprint.hash);
+    }
+}
+
+OverrideCache OverrideCache::Open(const std::filesystem::path& a_path) noexcept
+{
+    OverrideCache cache;
+    try {
+        if (!std::filesystem::exists(a_path)) {
+            return cache;
+        }
+
+        // Layout: magic, version, checksum of the body, body.
+        const MappedFile file{ a_path };
+        const auto       data = file.view();
+        std::uint32_t magic, version;
+        std::uint64_t checksum;
+        Reader        header{ data };
+        if (!header.Read(magic) || !header.Read(version) || !header.Read(checksum) || magic != kMagic ||
+            version != kVersion) {
+            SKSE::log::info("Override cache is outdated and will be rebuilt.");
+            return cache;
+        }
+
+        std::string_view body{ data };
+        body.remove_prefix(sizeof(magic) + sizeof(version) + sizeof(checksum));
+        if (HashBytes(body) != checksum) {
+            SKSE::log::warn("Override cache is damaged and will be rebuilt.");
+            return cache;
+        }
+
+        Reader        reader{ body };
+        std::uint32_t count;
+        if (!reader.Read(count)) {
+            return {};
+        }
+
+        cache._entries.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            std::string   path;
+            Entry         entry;
+            std::uint32_t size;
+            if (!reader.Read(path) || !ReadFingerprint(reader, entry.fingerprint) || !reader.Read(size)) {
+                return {};
+            }
+
+            entry.overrides.resize(size);
+            for (auto& ovr : entry.overrides) {
+                if (!reader.Read(ovr.name) || !ReadValue(reader, ovr.value)) {
+                    return {};
+                }
+            }
+            cache._entries.insert_or_assign(std::move(path), std::move(entry));
+        }
+        return reader.empty() ? std::move(cache) : OverrideCache{};
+    } catch (const std::exception& e) {
+        SKSE::log::warn("Failed to read override cache: {}.", e.what());
+        return {};
+    }
+}
+
+OverrideCache OverrideCache::FromFiles(std::span<const OverrideFile> a_files)
+{
+    OverrideCache cache;
+    cache._entries.reserve(a_files.size());
+    for (const auto& file : a_files) {
+        if (!file.error) {
+            cache._entries.insert_or_assign(file.name, Entry{ file.fingerprint, file.overrides });
+        }
+    }
+    return cache;
+}
+
+void OverrideCache::Save(const std::filesystem::path& a_path, std::span<const OverrideFile> a_files)
+{
+    Writer body;
+    body.Write(static_cast<std::uint32_t>(std::ranges::count_if(a_files, [](auto& a_file) { return !a_file.error; })));
+    for (const auto& file : a_files) {
+        if (file.error) {
+            continue;
+        }
+
+        body.Write(std::string_view{ file.name });
+        body.Write(file.fingerprint.size);
+        body.Write(file.fingerprint.mtime);
+        body.Write(file.fingerprint.hash);
+        body.Write(static_cast<std::uint32_t>(file.overrides.size()));
+        for (const auto& ovr : file.overrides) {
+            body.Write(std::string_view{ ovr.name });
+            WriteValue(body, ovr.value);
+        }
+    }
+
+    Writer out;
+    out.Write(kMagic);
+    out.Write(kVersion);
+    out.Write(HashBytes(body.buffer()));
+    out.buffer().append(body.buffer());
+    WriteFileAtomic(a_path, out.buffer());
+}
+
+std::optional<std::vector<Override>> OverrideCache::Take(std::string_view a_name, const Fingerprint& a_fingerprint)
+{
+    auto it = _entries.find(a_name);
+    if (it == _entries.end() || it->second.fingerprint != a_fingerprint) {
+        return std::nullopt;
+    }
+    return std::move(it->second.overrides);
+}
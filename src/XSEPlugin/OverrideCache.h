@@ -0,0 +1,37 @@
+#pragma once
+
+#include <XSEPlugin/Override.h>
+#include <XSEPlugin/Util/String.h>
+
+/// On-disk cache of the overrides already read from each file, so that files
+/// which did not change since the last launch need no TOML parsing.
+///
+/// A damaged cache is discarded as a whole; an entry whose fingerprint does not
+/// match the file any more is simply not used.
+class OverrideCache
+{
+public:
+    /// Read the cache at `a_path`. Never throws; a missing or bad cache is empty.
+    [[nodiscard]] static OverrideCache Open(const std::filesystem::path& a_path) noexcept;
+
+    /// Build a cache from files already in memory, e.g. those of the last load.
+    [[nodiscard]] static OverrideCache FromFiles(std::span<const OverrideFile> a_files);
+
+    /// Replace the cache at `a_path` with the overrides of every loaded file.
+    static void Save(const std::filesystem::path& a_path, std::span<const OverrideFile> a_files);
+
+    /// Move the cached overrides of a file out of the cache if its fingerprint
+    /// still matches. Safe to call concurrently for distinct paths.
+    [[nodiscard]] std::optional<std::vector<Override>> Take(std::string_view a_name, const Fingerprint& a_fingerprint);
+
+    [[nodiscard]] std::size_t size() const noexcept { return _entries.size(); }
+
+private:
+    struct Entry
+    {
+        Fingerprint           fingerprint;
+        std::vector<Override> overrides;
+    };
+
+    std::unordered_map<std::string, Entry, StringHash, std::equal_to<>> _entries;  // By UTF-8 path.
+};
@@ -0,0 +1,86 @@
+#include "OverrideTable.h"
+
+#include <XSEPlugin/Diagnostics.h>
+#include <XSEPlugin/SettingResolver.h>
+#include <XSEPlugin/SettingType.h>
+
+namespace
+{
+    /// Whether PatchProgram can write `a_value` to a setting of `a_type`.
+    /// Strings are expressions for numbers, which are checked when compiled.
+    [[nodiscard]] inline bool Accepts(RE::Setting::Type a_type, const OverrideValue& a_value) noexcept
+    {
+        switch (a_type) {
+        case RE::Setting::Type::kBool:
+            return OverrideValueAs<bool>(a_value).has_value();
+        case RE::Setting::Type::kFloat:
+            return OverrideValueAs<float>(a_value) || std::holds_alternative<std::string>(a_value);
+        case RE::Setting::Type::kSignedInteger:
+            return OverrideValueAs<std::int32_t>(a_value) || std::holds_alternative<std::string>(a_value);
+        case RE::Setting::Type::kUnsignedInteger:
+            return OverrideValueAs<std::uint32_t>(a_value) || std::holds_alternative<std::string>(a_value);
+        case RE::Setting::Type::kColor:
+            return OverrideValueAs<std::uint32_t>(a_value).has_value();
+        case RE::Setting::Type::kString:
+            return std::holds_alternative<std::string>(a_value);
+        default:
+            return true;
+        }
+    }
+}
+
+OverrideTable OverrideTable::Merge(std::span<const OverrideFile> a_files)
+{
+    OverrideTable table;
+    table.Fold(a_files, 0);
+    return table;
+}
+
+OverrideTable OverrideTable::Extend(std::span<const OverrideFile> a_files, std::uint32_t a_first) const
+{
+    auto table = *this;
+    table.Fold(a_files, a_first);
+    return table;
+}
+
+void OverrideTable::Fold(std::span<const OverrideFile> a_files, std::uint32_t a_first)
+{
+    std::size_t total = _entries.size();
+    for (const auto& file : a_files) {
+        total += file.overrides.size();
+    }
+    _entries.reserve(total);
+    _index.reserve(total);
+
+    for (std::uint32_t i = 0; i < a_files.size(); ++i) {
+        const auto index = a_first + i;
+        for (const auto& ovr : a_files[i].overrides) {
+            auto [it, inserted] = _index.try_emplace(ovr.name, static_cast<std::uint32_t>(_entries.size()));
+            if (inserted) {
+                _entries.emplace_back(ovr.name, ovr.value, index);
+                continue;
+            }
+
+            // A value that cannot be applied does not hide the one before it,
+            // just as it did not when each file was applied in turn.
+            auto& entry = _entries[it->second];
+            if (const auto type = SettingTypeOf(SplitName(ovr.name).name); !Accepts(type, ovr.value)) {
+                Diagnostics::Error("Setting '{}' in \"{}\" must be {}, so the value of an earlier file is kept.",
+                    ovr.name, a_files[i].filename(), SettingTypeName(type));
+                continue;
+            }
+
+            entry.overridden.push_back(entry.file);
+            entry.name = ovr.name;
+            entry.value = ovr.value;
+            entry.file = index;
+            ++_conflicts;
+        }
+    }
+}
+
+const OverrideTable::Entry* OverrideTable::Find(std::string_view a_name) const noexcept
+{
+    auto it = _index.find(a_name);
+    return it != _index.end() ? std::addressof(_entries[it->second]) : nullptr;
+}
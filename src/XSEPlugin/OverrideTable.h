@@ -0,0 +1,43 @@
+#pragma once
+
+#include <XSEPlugin/Override.h>
+#include <XSEPlugin/Util/String.h>
+
+/// The effective overrides of a set of files: one entry per setting, holding
+/// the value of the last file that sets it to a value of its type.
+class OverrideTable
+{
+public:
+    struct Entry
+    {
+        std::string                name;        // As written by the winning file.
+        OverrideValue              value;       // Value of the winning file.
+        std::uint32_t              file;        // Index of the winning file.
+        std::vector<std::uint32_t> overridden;  // Indices of the files it overrides, in load order.
+    };
+
+    /// Fold the overrides of `a_files`, in order, into one table.
+    [[nodiscard]] static OverrideTable Merge(std::span<const OverrideFile> a_files);
+
+    /// Fold the overrides of `a_files` into a copy of this table, as if they
+    /// came after its own files. `a_first` is the index of the first of them,
+    /// in the list that the indices of the table refer to.
+    [[nodiscard]] OverrideTable Extend(std::span<const OverrideFile> a_files, std::uint32_t a_first) const;
+
+    [[nodiscard]] const Entry* Find(std::string_view a_name) const noexcept;
+
+    /// Entries in order of first appearance.
+    [[nodiscard]] std::span<const Entry> entries() const noexcept { return _entries; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return _entries.size(); }
+
+    /// Number of overrides that were shadowed by a later file.
+    [[nodiscard]] std::size_t conflicts() const noexcept { return _conflicts; }
+
+private:
+    void Fold(std::span<const OverrideFile> a_files, std::uint32_t a_first);
+
+    std::vector<Entry>                                                                        _entries;
+    std::unordered_map<std::string, std::uint32_t, CaseInsensitiveHash, CaseInsensitiveEqual> _index;
+    std::size_t                                                                               _conflicts{ 0 };
+};
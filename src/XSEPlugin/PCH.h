@@ -10,11 +10,13 @@
 #include <cctype>
 #include <cerrno>
 #include <cfloat>
+#include <charconv>
 #include <chrono>
 #include <climits>
 #include <cmath>
 #include <compare>
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -72,6 +74,8 @@
 #include <fmt/ranges.h>
 #include <spdlog/spdlog.h>
 
+#include <XSEPlugin/Util/Transcode.h>
+
 using namespace std::literals::string_view_literals;
 
 namespace SKSE::stl
@@ -148,16 +152,16 @@ namespace SKSE::stl
 
 [[nodiscard]] inline std::filesystem::path StrToPath(std::string_view a_str)
 {
-    if (auto wstr = SKSE::stl::utf8_to_utf16(a_str)) {
-        return std::filesystem::path{ *std::move(wstr) };
+    std::wstring wstr(MaxUtf16Size(a_str.size()), L'\0');
+    auto         size = Utf8ToUtf16(a_str, { reinterpret_cast<char16_t*>(wstr.data()), wstr.size() });
+    if (!size) {
+        return {};
     }
-    return {};
+    wstr.resize(*size);
+    return std::filesystem::path{ std::move(wstr) };
 }
 
 [[nodiscard]] inline std::string PathToStr(const std::filesystem::path& a_path)
 {
-    if (auto str = SKSE::stl::utf16_to_utf8(a_path.native())) {
-        return *std::move(str);
-    }
-    return {};
+    return Utf16ToUtf8Lossy(AsUtf16(a_path.native()));
 }
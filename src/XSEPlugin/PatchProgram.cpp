@@ -0,0 +1,419 @@
+#include "PatchProgram.h"
+
+#include <XSEPlugin/Diagnostics.h>
+#include <XSEPlugin/Expression.h>
+#include <XSEPlugin/OriginalValues.h>
+#include <XSEPlugin/OverrideTable.h>
+#include <XSEPlugin/SettingResolver.h>
+#include <XSEPlugin/SettingType.h>
+#include <XSEPlugin/StringPool.h>
+
+namespace
+{
+    inline RE::Color IntToColor(std::uint32_t a_int) noexcept
+    {
+        // Unpack integer to (red, green, blue, alpha).
+        return RE::Color{ (a_int >> 24) & 0xFF, (a_int >> 16) & 0xFF, (a_int >> 8) & 0xFF, a_int & 0xFF };
+    }
+
+    [[nodiscard]] inline bool IsNumber(RE::Setting::Type a_type) noexcept
+    {
+        return a_type == RE::Setting::Type::kBool || a_type == RE::Setting::Type::kFloat ||
+               a_type == RE::Setting::Type::kSignedInteger || a_type == RE::Setting::Type::kUnsignedInteger;
+    }
+
+    /// Whether a string value of a setting of `a_type` is an expression. Any
+    /// other string value is of the wrong type, and reported as such.
+    [[nodiscard]] inline bool IsComputed(RE::Setting::Type a_type) noexcept
+    {
+        return a_type != RE::Setting::Type::kBool && IsNumber(a_type);
+    }
+
+    [[nodiscard]] inline double ReadNumber(const RE::Setting* a_setting) noexcept
+    {
+        switch (a_setting->GetType()) {
+        case RE::Setting::Type::kBool:
+            return a_setting->data.b ? 1.0 : 0.0;
+        case RE::Setting::Type::kFloat:
+            return a_setting->data.f;
+        case RE::Setting::Type::kSignedInteger:
+            return a_setting->data.i;
+        default:
+            return a_setting->data.u;
+        }
+    }
+
+    /// Round `a_value` to an integer of type T, if it fits.
+    template <class T>
+    [[nodiscard]] inline std::optional<T> ToInteger(double a_value) noexcept
+    {
+        const auto rounded = std::round(a_value);
+        if (rounded >= static_cast<double>(std::numeric_limits<T>::min()) &&
+            rounded <= static_cast<double>(std::numeric_limits<T>::max())) {
+            return static_cast<T>(rounded);
+        }
+        return std::nullopt;
+    }
+}
+
+PatchProgram PatchProgram::Compile(const OverrideTable& a_table, const OverrideTable* a_base)
+{
+    PatchProgram program;
+    program._ops.reserve(a_table.size());
+    program._names.reserve(a_table.size());
+
+    for (const auto& entry : a_table.entries()) {
+        const auto type = SettingTypeOf(SplitName(entry.name).name);
+        const auto source = IsComputed(type) ? std::get_if<std::string>(&entry.value) : nullptr;
+
+        // What an expression reads may have changed even if its text did not.
+        if (a_base && !source) {
+            if (auto prev = a_base->Find(entry.name); prev && prev->value == entry.value) {
+                ++program._unchanged;
+                continue;
+            }
+        }
+
+        Op op{ nullptr, type, 0, kLiteral, {} };
+        if (source) {
+            std::string error;
+            auto        expression = Expression::Compile(*source, error);
+            if (!expression) {
+                Diagnostics::Error("Setting '{}' has an invalid expression: {}.", entry.name, error);
+                ++program._rejected;
+                continue;
+            }
+
+            auto reference = std::ranges::find_if(expression->references(),
+                [](const std::string& a_name) { return !IsNumber(SettingTypeOf(SplitName(a_name).name)); });
+            if (reference != expression->references().end()) {
+                Diagnostics::Error("Setting '{}' reads '{}', which is not a number.", entry.name, *reference);
+                ++program._rejected;
+                continue;
+            }
+
+            op.formula = static_cast<std::uint32_t>(program._formulas.size());
+            program._formulas.push_back({ std::move(expression) });
+            program._ops.push_back(op);
+            program._names.push_back(entry.name);
+            continue;
+        }
+
+        bool valid = false;
+        switch (op.type) {
+        case RE::Setting::Type::kBool:
+            if (auto value = OverrideValueAs<bool>(entry.value)) {
+                op.value.b = *value;
+                valid = true;
+            }
+            break;
+        case RE::Setting::Type::kFloat:
+            if (auto value = OverrideValueAs<float>(entry.value)) {
+                op.value.f = *value;
+                valid = true;
+            }
+            break;
+        case RE::Setting::Type::kSignedInteger:
+            if (auto value = OverrideValueAs<std::int32_t>(entry.value)) {
+                op.value.i = *value;
+                valid = true;
+            }
+            break;
+        case RE::Setting::Type::kColor:
+        case RE::Setting::Type::kUnsignedInteger:
+            if (auto value = OverrideValueAs<std::uint32_t>(entry.value)) {
+                op.value.u = *value;
+                valid = true;
+            }
+            break;
+        case RE::Setting::Type::kString:
+            if (auto value = std::get_if<std::string>(&entry.value)) {
+                op.value.u = static_cast<std::uint32_t>(program._strings.size());
+                op.size = static_cast<std::uint32_t>(value->size());
+                program._strings += *value;
+                valid = true;
+            }
+            break;
+        default:
+            Diagnostics::Error("Unknown data type for setting '{}'.", entry.name);
+            ++program._rejected;
+            continue;
+        }
+
+        if (!valid) {
+            Diagnostics::Error("Setting '{}' must be {}.", entry.name, SettingTypeName(op.type));
+            ++program._rejected;
+            continue;
+        }
+
+        program._ops.push_back(op);
+        program._names.push_back(entry.name);
+    }
+
+    if (!program._formulas.empty()) {
+        program.SortByDependencies();
+    }
+
+    if (a_base) {
+        for (const auto& entry : a_base->entries()) {
+            if (!a_table.Find(entry.name)) {
+                program._dropped.push_back(entry.name);
+            }
+        }
+    }
+    return program;
+}
+
+void PatchProgram::SortByDependencies()
+{
+    std::unordered_map<std::string_view, std::uint32_t, CaseInsensitiveHash, CaseInsensitiveEqual> index;
+    for (std::uint32_t i = 0; i < _names.size(); ++i) {
+        index.emplace(_names[i], i);
+    }
+
+    // Kahn's algorithm; ops that read nothing keep their order.
+    std::vector<std::uint32_t>              pending(_ops.size(), 0);
+    std::vector<std::vector<std::uint32_t>> readers(_ops.size());
+    for (std::uint32_t i = 0; i < _ops.size(); ++i) {
+        if (_ops[i].formula == kLiteral) {
+            continue;
+        }
+        for (const auto& name : _formulas[_ops[i].formula].expression->references()) {
+            if (auto it = index.find(name); it != index.end()) {
+                readers[it->second].push_back(i);
+                ++pending[i];
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> order;
+    order.reserve(_ops.size());
+    for (std::uint32_t i = 0; i < _ops.size(); ++i) {
+        if (pending[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    for (std::size_t next = 0; next < order.size(); ++next) {
+        for (auto reader : readers[order[next]]) {
+            if (--pending[reader] == 0) {
+                order.push_back(reader);
+            }
+        }
+    }
+
+    for (std::uint32_t i = 0; i < _ops.size(); ++i) {
+        if (pending[i] != 0) {
+            Diagnostics::Error("Setting '{}' is left out, because its expression depends on settings that read "
+                               "each other.",
+                _names[i]);
+            ++_rejected;
+        }
+    }
+
+    std::vector<Op>          ops;
+    std::vector<std::string> names;
+    ops.reserve(order.size());
+    names.reserve(order.size());
+    for (auto i : order) {
+        ops.push_back(_ops[i]);
+        names.push_back(std::move(_names[i]));
+    }
+    _ops = std::move(ops);
+    _names = std::move(names);
+}
+
+void PatchProgram::Resolve(SettingResolver& a_resolver)
+{
+    if (_resolved) {
+        return;
+    }
+
+    std::vector<RE::Setting*> settings(_names.size());
+    a_resolver.Resolve(_names, settings);
+
+    for (auto& formula : _formulas) {
+        const auto names = formula.expression->references();
+        formula.firstReference = static_cast<std::uint32_t>(_references.size());
+        _references.resize(_references.size() + names.size());
+        a_resolver.Resolve(names, std::span{ _references }.subspan(formula.firstReference));
+    }
+
+    // Ops of unknown settings are removed in place; string offsets stay valid.
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < _ops.size(); ++i) {
+        auto op = _ops[i];
+        op.setting = settings[i];
+        if (!op.setting) {
+            Diagnostics::Error("Unknown setting '{}'.", _names[i]);
+            ++_rejected;
+            continue;
+        }
+
+        // The type was taken from the name. A setting registered with another
+        // type would be written through the wrong member of its data.
+        if (const auto type = op.setting->GetType(); type != op.type) {
+            Diagnostics::Error("Setting '{}' was left as it was, because its type is {}, but its name says {}.",
+                _names[i], SettingTypeName(type), SettingTypeName(op.type));
+            ++_rejected;
+            continue;
+        }
+
+        if (op.formula != kLiteral) {
+            const auto& formula = _formulas[op.formula];
+            const auto  names = formula.expression->references();
+            const auto  references = std::span{ _references }.subspan(formula.firstReference, names.size());
+            if (auto it = std::ranges::find(references, nullptr); it != references.end()) {
+                Diagnostics::Error("Setting '{}' reads unknown setting '{}'.", _names[i],
+                    names[static_cast<std::size_t>(it - references.begin())]);
+                ++_rejected;
+                continue;
+            }
+        }
+
+        _ops[kept] = op;
+        if (kept != i) {
+            _names[kept] = std::move(_names[i]);
+        }
+        ++kept;
+    }
+    _ops.resize(kept);
+    _names.resize(kept);
+
+    _reverts.resize(_dropped.size());
+    a_resolver.Resolve(_dropped, _reverts);
+    _resolved = true;
+}
+
+void PatchProgram::Commit(StringPool& a_strings, OriginalValues& a_originals) const
+{
+    for (const auto& op : _ops) {
+        a_originals.Record(op.setting);
+    }
+
+    // Restored first, so that expressions read the restored values.
+    for (auto setting : _reverts) {
+        if (setting) {
+            a_originals.Restore(setting, a_strings);
+        }
+    }
+
+    std::vector<double> references;
+    for (std::size_t i = 0; i < _ops.size(); ++i) {
+        const auto& op = _ops[i];
+        auto        value = op.value;
+        if (op.formula != kLiteral && !Evaluate(i, a_originals, references, value)) {
+            continue;
+        }
+
+        switch (op.type) {
+        case RE::Setting::Type::kBool:
+            op.setting->data.b = value.b;
+            break;
+        case RE::Setting::Type::kFloat:
+            op.setting->data.f = value.f;
+            break;
+        case RE::Setting::Type::kSignedInteger:
+            op.setting->data.i = value.i;
+            break;
+        case RE::Setting::Type::kColor:
+            op.setting->data.r = IntToColor(value.u);
+            break;
+        case RE::Setting::Type::kString:
+            a_strings.Assign(op.setting, GetString(op));
+            break;
+        default:
+            op.setting->data.u = value.u;
+            break;
+        }
+    }
+}
+
+bool PatchProgram::Evaluate(std::size_t a_index, const OriginalValues& a_originals, std::vector<double>& a_references,
+    Op::Value& a_value) const
+{
+    const auto& op = _ops[a_index];
+    const auto& formula = _formulas[op.formula];
+    const auto& expression = *formula.expression;
+
+    a_references.resize(expression.references().size());
+    for (std::size_t i = 0; i < a_references.size(); ++i) {
+        a_references[i] = ReadNumber(_references[formula.firstReference + i]);
+    }
+
+    const auto base = a_originals.GetNumber(op.setting).value_or(ReadNumber(op.setting));
+    const auto result = expression.Evaluate(base, a_references);
+
+    std::optional<std::string_view> error;
+    switch (op.type) {
+    case RE::Setting::Type::kFloat:
+        a_value.f = static_cast<float>(result);
+        if (!std::isfinite(a_value.f)) {
+            error = "float"sv;
+        }
+        break;
+    case RE::Setting::Type::kSignedInteger:
+        if (auto value = ToInteger<std::int32_t>(result)) {
+            a_value.i = *value;
+        } else {
+            error = "signed integer"sv;
+        }
+        break;
+    default:
+        if (auto value = ToInteger<std::uint32_t>(result)) {
+            a_value.u = *value;
+        } else {
+            error = "unsigned integer"sv;
+        }
+        break;
+    }
+
+    if (error) {
+        Diagnostics::Error("Setting '{}' was left as it was, because {} is not a valid {}.", _names[a_index], result,
+            *error);
+        return false;
+    }
+    return true;
+}
+
+void PatchProgram::Log() const
+{
+    // At summary verbosity there is usually nothing to format.
+    if (!Diagnostics::ShouldLog(Diagnostics::GetDetailLevel())) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < _ops.size(); ++i) {
+        const auto& op = _ops[i];
+        const auto& name = _names[i];
+        if (op.formula != kLiteral) {
+            Diagnostics::Detail("Set {} = {} ({})", name, _formulas[op.formula].expression->source(),
+                ReadNumber(op.setting));
+            continue;
+        }
+
+        switch (op.type) {
+        case RE::Setting::Type::kBool:
+            Diagnostics::Detail("Set {} = {}", name, op.value.b);
+            break;
+        case RE::Setting::Type::kFloat:
+            Diagnostics::Detail("Set {} = {:.6f}", name, op.value.f);
+            break;
+        case RE::Setting::Type::kSignedInteger:
+            Diagnostics::Detail("Set {} = {}", name, op.value.i);
+            break;
+        case RE::Setting::Type::kColor:
+            Diagnostics::Detail("Set {} = 0x{:08X}", name, op.value.u);
+            break;
+        case RE::Setting::Type::kString:
+            Diagnostics::Detail("Set {} = {}", name, GetString(op));
+            break;
+        default:
+            Diagnostics::Detail("Set {} = {}", name, op.value.u);
+            break;
+        }
+    }
+
+    for (const auto& name : _dropped) {
+        Diagnostics::Detail("Restored {}, which is no longer overridden.", name);
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+class Expression;
+class OriginalValues;
+class OverrideTable;
+class SettingResolver;
+class StringPool;
+
+/// Type-checked writes to game settings, compiled from an override table.
+/// Compiling only needs the setting names, so it may run before data is loaded;
+/// resolving then looks the settings up. Committing cannot fail, so a program
+/// is either applied as a whole or not at all; only an expression whose result
+/// does not fit its setting leaves that one setting as it was.
+class PatchProgram
+{
+public:
+    static constexpr std::uint32_t kLiteral = std::numeric_limits<std::uint32_t>::max();
+
+    struct Op
+    {
+        union Value
+        {
+            bool          b;
+            float         f;
+            std::int32_t  i;
+            std::uint32_t u;  // Also colors, and the offset of a string value.
+        };
+
+        RE::Setting*      setting;  // Null until resolved.
+        RE::Setting::Type type;
+        std::uint32_t     size;     // Length of a string value.
+        std::uint32_t     formula;  // Index of the expression that computes the value, or kLiteral.
+        Value             value;
+    };
+
+    /// Compile the entries of `a_table` whose value differs from `a_base`, or
+    /// all of them if there is no base, and restore the entries of `a_base`
+    /// that `a_table` no longer has. Values are converted to the type given by
+    /// the setting name; values of the wrong type are reported and left out.
+    /// A string value of a float or integer setting is compiled as an
+    /// Expression, which may read any number setting, bools included. Those
+    /// are always written, as what they read may have changed, and are ordered
+    /// after the settings they read; settings that read each other are left
+    /// out. Safe to call from any thread.
+    [[nodiscard]] static PatchProgram Compile(const OverrideTable& a_table, const OverrideTable* a_base);
+
+    /// Look up the settings of the ops and of the dropped entries, in any
+    /// collection. Overrides of unknown settings are reported and left out.
+    /// Only after data is loaded.
+    void Resolve(SettingResolver& a_resolver);
+
+    [[nodiscard]] bool resolved() const noexcept { return _resolved; }
+
+    /// Record the values the ops replace the first time, restore the dropped
+    /// settings, then write every op to the game, evaluating expressions as
+    /// they come. The program must be resolved. Main thread only. A program may
+    /// be committed again to restore its values.
+    void Commit(StringPool& a_strings, OriginalValues& a_originals) const;
+
+    /// Log the writes and restores of Commit, after it, as details. Expressions
+    /// are logged with the value the setting has then.
+    void Log() const;
+
+    [[nodiscard]] std::span<const Op> ops() const noexcept { return _ops; }
+
+    /// Entries of the table left out because the base has the same value.
+    [[nodiscard]] std::size_t unchanged() const noexcept { return _unchanged; }
+
+    /// Entries of the base that the table no longer has, which are restored.
+    [[nodiscard]] std::size_t dropped() const noexcept { return _dropped.size(); }
+
+    /// Settings of the dropped entries, once resolved; null if unknown.
+    [[nodiscard]] std::span<RE::Setting* const> reverts() const noexcept { return _reverts; }
+
+    /// Entries of the table left out because of an unknown setting or a value
+    /// of the wrong type.
+    [[nodiscard]] std::size_t rejected() const noexcept { return _rejected; }
+
+private:
+    [[nodiscard]] std::string_view GetString(const Op& a_op) const noexcept
+    {
+        return std::string_view{ _strings }.substr(a_op.value.u, a_op.size);
+    }
+
+    struct Formula
+    {
+        std::shared_ptr<const Expression> expression;
+        std::uint32_t                     firstReference{ 0 };  // Into `_references`, once resolved.
+    };
+
+    /// Compute the value of the expression op `a_index`. `a_references` is scratch space.
+    [[nodiscard]] bool Evaluate(std::size_t a_index, const OriginalValues& a_originals,
+        std::vector<double>& a_references, Op::Value& a_value) const;
+
+    /// Order the ops so that expressions come after the ops they read.
+    void SortByDependencies();
+
+    std::vector<Op>           _ops;
+    std::vector<std::string>  _names;    // Setting name of each op, for logging only.
+    std::string               _strings;  // Values of string ops, back to back.
+    std::vector<RE::Setting*> _reverts;  // Settings of the dropped entries once resolved; null if unknown.
+    std::vector<std::string>  _dropped;  // Names of the dropped entries.
+    std::vector<Formula>      _formulas;
+    std::vector<RE::Setting*> _references;  // Settings read by the formulas, back to back.
+    std::size_t               _unchanged{ 0 };
+    std::size_t               _rejected{ 0 };
+    bool                      _resolved{ false };
+};
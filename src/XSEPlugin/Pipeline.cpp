@@ -0,0 +1,115 @@
+#include "Pipeline.h"
+
+#include <XSEPlugin/Diagnostics.h>
+#include <XSEPlugin/OverrideCache.h>
+#include <XSEPlugin/Util/Hash.h>
+#include <XSEPlugin/Util/MappedFile.h>
+
+namespace Pipeline
+{
+    std::vector<std::filesystem::path> ScanDir(const std::filesystem::path& a_root)
+    {
+        auto st = std::filesystem::status(a_root);
+
+        if (!std::filesystem::exists(st)) {
+            Diagnostics::Warn("\"{}\" does not exist.", PathToStr(a_root));
+            return {};
+        }
+
+        if (!std::filesystem::is_directory(st)) {
+            Diagnostics::Error("\"{}\" is not a directory.", PathToStr(a_root));
+            return {};
+        }
+
+        static const std::filesystem::path kExtension{ L".toml"sv };
+
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(8);
+
+        for (const auto& entry : std::filesystem::directory_iterator{ a_root }) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+
+            if (const auto& path = entry.path(); path.extension() == kExtension) {
+                paths.push_back(path);
+            }
+        }
+
+        std::ranges::sort(paths);
+        return paths;
+    }
+
+    std::vector<ProfileDir> ScanProfiles(const std::filesystem::path& a_root)
+    {
+        const auto      dir = a_root / L"Profiles"sv;
+        std::error_code ec;
+        if (!std::filesystem::is_directory(dir, ec)) {
+            return {};
+        }
+
+        std::vector<ProfileDir> profiles;
+        for (const auto& entry : std::filesystem::directory_iterator{ dir }) {
+            if (entry.is_directory()) {
+                profiles.emplace_back(PathToStr(entry.path().filename()), ScanDir(entry.path()));
+            }
+        }
+
+        std::ranges::sort(profiles, {}, &ProfileDir::name);
+        return profiles;
+    }
+
+    bool ReadOverrideFile(OverrideFile& a_file, OverrideCache& a_cache, LoadStats::File& a_stats)
+    {
+        const LoadStats::Timer read;
+        const auto mtime = std::filesystem::last_write_time(a_file.path).time_since_epoch().count();
+        const MappedFile file{ a_file.path };
+        const auto data = file.view();
+
+        a_file.fingerprint = { data.size(), static_cast<std::int64_t>(mtime), HashBytes(data) };
+        if (auto overrides = a_cache.Take(a_file.name, a_file.fingerprint)) {
+            a_file.overrides = *std::move(overrides);
+            a_stats.read = read.Stop();
+            a_stats.cached = true;
+            return true;
+        }
+        a_stats.read = read.Stop();
+
+        const LoadStats::Timer parse;
+        a_file.overrides = ParseOverrides(data, a_file.name);
+        a_stats.parse = parse.Stop();
+        return false;
+    }
+
+    std::vector<OverrideFile> ReadOverrideFiles(std::vector<std::filesystem::path> a_paths,
+        OverrideCache& a_cache, LoadStats& a_stats)
+    {
+        std::vector<OverrideFile>    files(a_paths.size());
+        std::vector<LoadStats::File> stats(a_paths.size());
+        for (std::size_t i = 0; i < a_paths.size(); ++i) {
+            files[i].path = std::move(a_paths[i]);
+            files[i].name = PathToStr(files[i].path);
+        }
+
+        std::for_each(std::execution::par, files.begin(), files.end(), [&](OverrideFile& a_file) {
+            auto& fileStats = stats[static_cast<std::size_t>(std::addressof(a_file) - files.data())];
+            try {
+                ReadOverrideFile(a_file, a_cache, fileStats);
+            } catch (...) {
+                a_file.error = std::current_exception();
+                fileStats.failed = true;
+            }
+        });
+
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            auto& fileStats = stats[i];
+            fileStats.name = files[i].name;
+            fileStats.overrides = files[i].overrides.size();
+            a_stats.read += fileStats.read;
+            a_stats.parse += fileStats.parse;
+        }
+        a_stats.files.insert(a_stats.files.end(), std::make_move_iterator(stats.begin()),
+            std::make_move_iterator(stats.end()));
+        return files;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <XSEPlugin/LoadStats.h>
+#include <XSEPlugin/Override.h>
+
+class OverrideCache;
+
+/// The stages that read override files from disk.
+namespace Pipeline
+{
+    /// List the override files in `a_root`, sorted by path.
+    [[nodiscard]] std::vector<std::filesystem::path> ScanDir(const std::filesystem::path& a_root);
+
+    struct ProfileDir
+    {
+        std::string                        name;
+        std::vector<std::filesystem::path> paths;  // As listed by ScanDir.
+    };
+
+    /// List the profiles in the `Profiles` directory of `a_root`, one per
+    /// subdirectory, sorted by name.
+    [[nodiscard]] std::vector<ProfileDir> ScanProfiles(const std::filesystem::path& a_root);
+
+    /// Read one file, reusing the cached overrides if the file did not change,
+    /// and time it in `a_stats`. Return whether the cache was used.
+    bool ReadOverrideFile(OverrideFile& a_file, OverrideCache& a_cache, LoadStats::File& a_stats);
+
+    /// Read all files at once. The result keeps the scan order, and an error is
+    /// kept with its file to be reported when that file is reached. The time of
+    /// each file is added to `a_stats`.
+    [[nodiscard]] std::vector<OverrideFile> ReadOverrideFiles(std::vector<std::filesystem::path> a_paths,
+        OverrideCache& a_cache, LoadStats& a_stats);
+}
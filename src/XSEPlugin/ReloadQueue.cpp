@@ -0,0 +1,111 @@
+#include "ReloadQueue.h"
+
+std::uint64_t ReloadQueue::Request()
+{
+    std::scoped_lock lock{ _lock };
+    const auto       ticket = ++_requested;
+    if (!_busy) {
+        Start();
+    }
+    return ticket;
+}
+
+ReloadQueue::Status ReloadQueue::GetStatus() const
+{
+    std::scoped_lock lock{ _lock };
+    return { _requested, _completed, _failed };
+}
+
+void ReloadQueue::WriteStatus(char* a_dst, std::size_t a_len) const
+{
+    if (!a_dst || a_len == 0) {
+        return;
+    }
+
+    const auto [requested, completed, failed] = GetStatus();
+
+    const auto room = static_cast<std::ptrdiff_t>(a_len - 1);
+    const auto outcome = failed ? "failed"sv : "is done"sv;
+    const auto written = [&]() {
+        if (requested == 0) {
+            return std::format_to_n(a_dst, room, "No reload was requested.").size;
+        } else if (completed == 0) {
+            return std::format_to_n(a_dst, room, "Reload #{} is under way.", requested).size;
+        } else if (completed == requested) {
+            return std::format_to_n(a_dst, room, "Reload #{} {}.\n", completed, outcome).size;
+        } else {
+            return std::format_to_n(a_dst, room, "Reload #{} {}. Reload #{} is under way.\n", completed, outcome,
+                requested)
+                .size;
+        }
+    }();
+
+    // Then what the last reload that was done logged.
+    const auto size = std::min(static_cast<std::size_t>(written), a_len - 1);
+    if (completed != 0) {
+        _result.CopyTo(a_dst + size, a_len - size, Diagnostics::kTruncated);
+    } else {
+        a_dst[size] = '\0';
+    }
+}
+
+void ReloadQueue::Start()
+{
+    _busy = true;
+    _started = _requested;
+
+    // The previous worker only posted its commit, which has run since.
+    _worker = std::jthread{ [this, ticket = _started] {
+        // What reading logs is kept apart from the buffer of the main thread
+        // until the commit, which starts with it.
+        auto                                        messages = std::make_shared<Diagnostics::Buffer>();
+        std::shared_ptr<GameSettings::PreparedLoad> load;
+        std::string                                 error;
+        {
+            Diagnostics::Capture capture{ *messages };
+            try {
+                load = GameSettings::PrepareReload();
+            } catch (const std::exception& e) {
+                error = SKSE::stl::ansi_to_utf8(e.what()).value_or(e.what());
+            } catch (...) {
+                // Nothing may escape the thread, which would terminate the game.
+                error = "unknown error";
+            }
+        }
+
+        SKSE::GetTaskInterface()->AddTask([this, load = std::move(load), ticket, error = std::move(error),
+                                              messages = std::move(messages)]() mutable {
+            Commit(std::move(load), ticket, std::move(error), std::move(messages));
+        });
+    } };
+}
+
+void ReloadQueue::Commit(std::shared_ptr<GameSettings::PreparedLoad> a_load, std::uint64_t a_ticket,
+    std::string a_error, std::shared_ptr<const Diagnostics::Buffer> a_messages)
+{
+    bool failed = !a_load;
+    {
+        Diagnostics::Capture capture{ _result };
+        _result.Append(*a_messages);
+        if (a_load) {
+            try {
+                GameSettings::CommitReload(std::move(a_load));
+            } catch (...) {
+                // Already logged.
+                failed = true;
+            }
+        } else {
+            Diagnostics::Error("Failed to read the override files: {}.", a_error.empty() ? "unknown error"sv : a_error);
+        }
+    }
+
+    std::scoped_lock lock{ _lock };
+    _completed = a_ticket;
+    _failed = failed;
+    _busy = false;
+
+    // Everything requested while this reload was under way is merged into one more.
+    if (_requested != _started) {
+        Start();
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <XSEPlugin/Diagnostics.h>
+#include <XSEPlugin/GameSettings.h>
+#include <XSEPlugin/Util/Singleton.h>
+
+/// Reloads the override files off the main thread. Requests that arrive while
+/// a reload is under way are merged into one more reload after it, however many
+/// there are. Each reload is written to the game in one task on the main thread.
+class ReloadQueue : public Singleton<ReloadQueue>
+{
+public:
+    /// Ask for a reload, and return its ticket. Returns at once. Safe to call
+    /// from any thread.
+    std::uint64_t Request();
+
+    struct Status
+    {
+        std::uint64_t requested{ 0 };  // Last ticket handed out.
+        std::uint64_t completed{ 0 };  // Last ticket done; its reload covers every ticket before it.
+        bool          failed{ false };  // Whether the reload of `completed` failed.
+    };
+
+    /// Safe to call from any thread.
+    [[nodiscard]] Status GetStatus() const;
+
+    /// Write the status, followed by the messages of the last reload that was
+    /// done, to `a_dst`, which holds `a_len` bytes. Main thread only.
+    void WriteStatus(char* a_dst, std::size_t a_len) const;
+
+private:
+    /// Start reading the files for every ticket requested so far. `_lock` must be held.
+    void Start();
+
+    /// Write the load read for `a_ticket`, or report `a_error`. `a_messages`
+    /// holds what reading it logged. Main thread only.
+    void Commit(std::shared_ptr<GameSettings::PreparedLoad> a_load, std::uint64_t a_ticket, std::string a_error,
+        std::shared_ptr<const Diagnostics::Buffer> a_messages);
+
+    mutable std::mutex  _lock;
+    std::uint64_t       _requested{ 0 };
+    std::uint64_t       _started{ 0 };  // Last ticket covered by the reload under way.
+    std::uint64_t       _completed{ 0 };
+    bool                _failed{ false };
+    bool                _busy{ false };  // From Start until the reload is committed.
+    std::jthread        _worker;
+    Diagnostics::Buffer _result;  // Messages of the last reload that was done. Main thread only.
+};
@@ -0,0 +1,128 @@
+#include "SettingDump.h"
+
+#include <XSEPlugin/AppliedLoad.h>
+#include <XSEPlugin/GameSettings.h>
+
+namespace
+{
+    /// Room kept at the end of every page for its last line.
+    constexpr std::size_t kFooterSize = 64;
+
+    /// Formats into a fixed buffer. Text past its end is dropped, but still
+    /// counted, so the caller can tell whether it fit.
+    class PageWriter
+    {
+    public:
+        PageWriter(char* a_buf, std::size_t a_capacity) noexcept :
+            _buf(a_buf),
+            _capacity(a_capacity)
+        {}
+
+        template <class... Args>
+        void Write(std::format_string<Args...> a_fmt, Args&&... a_args)
+        {
+            const auto pos = std::min(_size, _capacity);
+            const auto result = std::format_to_n(_buf + pos, static_cast<std::ptrdiff_t>(_capacity - pos), a_fmt,
+                std::forward<Args>(a_args)...);
+            _size += static_cast<std::size_t>(result.size);
+        }
+
+        void WriteValue(const OverrideValue& a_value)
+        {
+            std::visit(
+                [this]<class T>(const T& a_value) {
+                    if constexpr (std::is_same_v<T, std::monostate>) {
+                        Write("(unsupported)");
+                    } else if constexpr (std::is_same_v<T, std::string>) {
+                        Write("\"{}\"", a_value);
+                    } else {
+                        Write("{}", a_value);
+                    }
+                },
+                a_value);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return _size; }
+        [[nodiscard]] bool        fits() const noexcept { return _size <= _capacity; }
+
+        /// Drop everything after the first `a_size` bytes.
+        void Truncate(std::size_t a_size) noexcept { _size = std::min(_size, a_size); }
+
+    private:
+        char*       _buf;
+        std::size_t _capacity;
+        std::size_t _size{ 0 };
+    };
+
+    inline void WriteEntry(PageWriter& a_writer, const AppliedLoad& a_applied, const OverrideTable::Entry& a_entry)
+    {
+        const auto& files = a_applied.loaded->files;
+        const auto effective = a_applied.Describe(a_entry);
+        a_writer.Write("{} ({}) = ", effective.name, SettingTypeName(effective.type));
+        a_writer.WriteValue(*effective.value);
+        a_writer.Write(" [{}", files[a_entry.file].filename());
+        for (std::size_t i = 0; i < a_entry.overridden.size(); ++i) {
+            a_writer.Write("{}{}", i == 0 ? "; overrides " : ", ", files[a_entry.overridden[i]].filename());
+        }
+        a_writer.Write("]\n");
+    }
+}
+
+void SettingDump::WritePage(char* a_buf, std::size_t a_len)
+{
+    if (!a_buf || a_len == 0) {
+        return;
+    }
+
+    if (auto applied = GameSettings::GetApplied(); applied != _applied) {
+        _applied = std::move(applied);
+        _next = 0;
+    }
+
+    const auto entries = _applied->table().entries();
+    if (_next >= entries.size()) {
+        _next = 0;
+    }
+
+    // Whole entries first, keeping room for the last line.
+    const auto room = a_len - 1;
+    const auto body = room > kFooterSize ? room - kFooterSize : 0;
+    if (body == 0 && !entries.empty()) {
+        // Not even part of an entry fits, so none is passed over.
+        PageWriter footer{ a_buf, room };
+        footer.Write("-- The buffer is too small for a page --");
+        a_buf[std::min(footer.size(), room)] = '\0';
+        return;
+    }
+
+    PageWriter writer{ a_buf, body };
+    const auto first = _next;
+    bool       cut = false;
+    while (_next < entries.size()) {
+        const auto size = writer.size();
+        WriteEntry(writer, *_applied, entries[_next]);
+        if (!writer.fits()) {
+            if (_next == first) {
+                // An entry larger than a whole page is cut short rather than never shown.
+                writer.Truncate(body);
+                cut = true;
+                ++_next;
+            } else {
+                writer.Truncate(size);
+            }
+            break;
+        }
+        ++_next;
+    }
+
+    PageWriter footer{ a_buf + writer.size(), room - writer.size() };
+    if (entries.empty()) {
+        footer.Write("No overrides are in effect.");
+    } else if (_next < entries.size()) {
+        footer.Write("{}-- {}-{} of {}; call again for more --", cut ? "...\n" : "", first + 1, _next,
+            entries.size());
+    } else {
+        footer.Write("{}-- {}-{} of {} (end) --", cut ? "...\n" : "", first + 1, _next, entries.size());
+    }
+    a_buf[writer.size() + std::min(footer.size(), room - writer.size())] = '\0';
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+struct AppliedLoad;
+
+/// Lists the overrides in effect into a caller's buffer, one page per call,
+/// each page starting where the previous one ended. Text is formatted in place,
+/// so a page allocates nothing.
+class SettingDump
+{
+public:
+    /// Write as many whole entries as fit into `a_buf`, which holds `a_len`
+    /// bytes, then a line that tells which entries the page holds, and
+    /// terminate it with NUL. Starts over after the last page, and when the
+    /// overrides in effect changed since the previous page. A buffer with no
+    /// room for entries next to that line only gets a note, and skips nothing.
+    void WritePage(char* a_buf, std::size_t a_len);
+
+private:
+    std::shared_ptr<const AppliedLoad> _applied;
+    std::size_t                        _next{ 0 };  // First entry of the next page.
+};
@@ -0,0 +1,83 @@
+#include "SettingResolver.h"
+
+namespace
+{
+    constexpr std::string_view kINISection{ "INI" };
+    constexpr std::string_view kINIPrefsSection{ "INIPrefs" };
+}
+
+std::optional<SettingCollection> CollectionOfSection(std::string_view a_section) noexcept
+{
+    if (a_section == kINISection) {
+        return SettingCollection::kINI;
+    }
+    if (a_section == kINIPrefsSection) {
+        return SettingCollection::kINIPrefs;
+    }
+    return std::nullopt;
+}
+
+std::string QualifyName(SettingCollection a_collection, std::string_view a_name)
+{
+    switch (a_collection) {
+    case SettingCollection::kINI:
+        return std::format("{}.{}", kINISection, a_name);
+    case SettingCollection::kINIPrefs:
+        return std::format("{}.{}", kINIPrefsSection, a_name);
+    default:
+        return std::string{ a_name };
+    }
+}
+
+QualifiedName SplitName(std::string_view a_qualified) noexcept
+{
+    // Game setting names never contain a dot.
+    if (auto dot = a_qualified.find('.'); dot != std::string_view::npos) {
+        if (auto collection = CollectionOfSection(a_qualified.substr(0, dot))) {
+            return { *collection, a_qualified.substr(dot + 1) };
+        }
+    }
+    return { SettingCollection::kGame, a_qualified };
+}
+
+void SettingResolver::Resolve(std::span<const std::string> a_names, std::span<RE::Setting*> a_settings)
+{
+    for (std::size_t i = 0; i < a_names.size(); ++i) {
+        a_settings[i] = Find(SplitName(a_names[i]));
+    }
+}
+
+RE::Setting* SettingResolver::Find(const QualifiedName& a_name)
+{
+    const Index* index = nullptr;
+    switch (a_name.collection) {
+    case SettingCollection::kINI:
+        index = std::addressof(GetIndex(_ini, RE::INISettingCollection::GetSingleton()));
+        break;
+    case SettingCollection::kINIPrefs:
+        index = std::addressof(GetIndex(_iniPrefs, RE::INIPrefSettingCollection::GetSingleton()));
+        break;
+    default:
+        return RE::GameSettingCollection::GetSingleton()->GetSetting(a_name.name.data());
+    }
+
+    auto it = index->find(a_name.name);
+    return it != index->end() ? it->second : nullptr;
+}
+
+const SettingResolver::Index& SettingResolver::GetIndex(LazyIndex& a_lazy, RE::INISettingCollection* a_collection)
+{
+    std::call_once(a_lazy.once, [&] {
+        if (!a_collection) {
+            return;
+        }
+
+        // The game searches the list from the front, so the first of two equal names wins.
+        for (auto setting : a_collection->settings) {
+            if (setting && setting->GetName()) {
+                a_lazy.index.try_emplace(setting->GetName(), setting);
+            }
+        }
+    });
+    return a_lazy.index;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <XSEPlugin/Util/Singleton.h>
+#include <XSEPlugin/Util/String.h>
+
+/// The setting collections that override files can target.
+enum class SettingCollection : std::uint8_t
+{
+    kGame,      // Top-level keys: GameSettingCollection.
+    kINI,       // [INI] section: INISettingCollection.
+    kINIPrefs,  // [INIPrefs] section: INIPrefSettingCollection.
+};
+
+/// Override names are qualified by the section of their collection and a dot,
+/// e.g. "INI.fLightLODStartFade:Display"; game settings have no section.
+struct QualifiedName
+{
+    SettingCollection collection;
+    std::string_view  name;  // As the collection knows it.
+};
+
+/// The section of the override files that targets `a_section`, if any.
+[[nodiscard]] std::optional<SettingCollection> CollectionOfSection(std::string_view a_section) noexcept;
+
+[[nodiscard]] std::string QualifyName(SettingCollection a_collection, std::string_view a_name);
+
+/// Split a qualified name. The name part is a suffix of `a_qualified`, so it is
+/// null-terminated if `a_qualified` is.
+[[nodiscard]] QualifiedName SplitName(std::string_view a_qualified) noexcept;
+
+/// Finds settings by qualified name in every collection. The game collection
+/// is a hash map already, but the INI collections are lists, so each is
+/// indexed once, the first time one of its settings is asked for.
+///
+/// Only after data is loaded, when the collections no longer change. Safe to
+/// call from any thread.
+class SettingResolver : public Singleton<SettingResolver>
+{
+public:
+    /// Look up all `a_names` at once into `a_settings`, which has the same
+    /// size. Unknown settings are null.
+    void Resolve(std::span<const std::string> a_names, std::span<RE::Setting*> a_settings);
+
+private:
+    using Index = std::unordered_map<std::string_view, RE::Setting*, CaseInsensitiveHash, CaseInsensitiveEqual>;
+
+    struct LazyIndex
+    {
+        std::once_flag once;
+        Index          index;
+    };
+
+    [[nodiscard]] RE::Setting* Find(const QualifiedName& a_name);
+
+    [[nodiscard]] static const Index& GetIndex(LazyIndex& a_lazy, RE::INISettingCollection* a_collection);
+
+    LazyIndex _ini;
+    LazyIndex _iniPrefs;
+};
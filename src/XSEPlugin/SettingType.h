@@ -0,0 +1,59 @@
+#pragma once
+
+/// The setting type of each first letter of a setting name. Settings are
+/// looked up regardless of case, so an upper-case letter names the same type
+/// as its lower-case one.
+inline constexpr auto kSettingTypeOfPrefix = [] {
+    std::array<RE::Setting::Type, 256> table{};
+    table.fill(RE::Setting::Type::kUnknown);
+
+    const auto add = [&](char a_prefix, RE::Setting::Type a_type) {
+        table[static_cast<unsigned char>(a_prefix)] = a_type;
+        table[static_cast<unsigned char>(a_prefix - 'a' + 'A')] = a_type;
+    };
+    add('b', RE::Setting::Type::kBool);
+    add('f', RE::Setting::Type::kFloat);
+    add('i', RE::Setting::Type::kSignedInteger);
+    add('r', RE::Setting::Type::kColor);
+    add('s', RE::Setting::Type::kString);
+    add('u', RE::Setting::Type::kUnsignedInteger);
+    return table;
+}();
+
+/// The type of the setting named `a_name`. The game gives every setting the
+/// type of the first letter of its name, so this agrees with
+/// RE::Setting::GetType of the setting that `a_name` finds, without looking it
+/// up, and works on any thread before data is loaded.
+[[nodiscard]] constexpr RE::Setting::Type SettingTypeOf(std::string_view a_name) noexcept
+{
+    return a_name.empty() ? RE::Setting::Type::kUnknown :
+                            kSettingTypeOfPrefix[static_cast<unsigned char>(a_name.front())];
+}
+
+[[nodiscard]] constexpr std::string_view SettingTypeName(RE::Setting::Type a_type) noexcept
+{
+    switch (a_type) {
+    case RE::Setting::Type::kBool:
+        return "bool"sv;
+    case RE::Setting::Type::kFloat:
+        return "float"sv;
+    case RE::Setting::Type::kSignedInteger:
+        return "signed integer"sv;
+    case RE::Setting::Type::kColor:
+        return "color"sv;
+    case RE::Setting::Type::kString:
+        return "string"sv;
+    case RE::Setting::Type::kUnsignedInteger:
+        return "unsigned integer"sv;
+    default:
+        return "unknown"sv;
+    }
+}
+
+static_assert(SettingTypeOf("fJumpHeightMin"sv) == RE::Setting::Type::kFloat);
+static_assert(SettingTypeOf("sHealth"sv) == RE::Setting::Type::kString);
+static_assert(SettingTypeOf("FJumpHeightMin"sv) == RE::Setting::Type::kFloat);
+static_assert(SettingTypeOf("BDisableAutoVanityMode"sv) == RE::Setting::Type::kBool);
+static_assert(SettingTypeOf("SHealth"sv) == RE::Setting::Type::kString);
+static_assert(SettingTypeOf("JumpHeight"sv) == RE::Setting::Type::kUnknown);
+static_assert(SettingTypeOf(""sv) == RE::Setting::Type::kUnknown);
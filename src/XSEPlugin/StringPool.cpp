@@ -0,0 +1,31 @@
+#include "StringPool.h"
+
+void StringPool::Assign(RE::Setting* a_setting, std::string_view a_value)
+{
+    auto it = _strings.find(a_value);
+    if (it == _strings.end()) {
+        it = _strings.emplace(a_value, 0).first;
+    }
+    ++it->second;
+
+    if (auto [owner, inserted] = _owners.try_emplace(a_setting, it); !inserted) {
+        --owner->second->second;
+        owner->second = it;
+    }
+
+    // The game never writes through this pointer.
+    a_setting->data.s = const_cast<char*>(it->first.c_str());
+}
+
+void StringPool::Release(RE::Setting* a_setting)
+{
+    if (auto owner = _owners.find(a_setting); owner != _owners.end()) {
+        --owner->second->second;
+        _owners.erase(owner);
+    }
+}
+
+std::size_t StringPool::Collect()
+{
+    return std::erase_if(_strings, [](const auto& a_entry) { return a_entry.second == 0; });
+}
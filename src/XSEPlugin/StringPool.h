@@ -0,0 +1,31 @@
+#pragma once
+
+#include <XSEPlugin/Util/String.h>
+
+/// Owns the values written to string settings. Identical values share one
+/// allocation, and a value is freed by Collect once no setting uses it.
+///
+/// Main thread only, like the settings themselves.
+class StringPool
+{
+public:
+    /// Point `a_setting` to a pooled copy of `a_value`. The value it held
+    /// before is released if it came from this pool.
+    void Assign(RE::Setting* a_setting, std::string_view a_value);
+
+    /// Release the value `a_setting` points to, before it is pointed elsewhere.
+    void Release(RE::Setting* a_setting);
+
+    /// Free the values that no setting uses any more. Return how many were freed.
+    std::size_t Collect();
+
+    /// Number of distinct values held.
+    [[nodiscard]] std::size_t size() const noexcept { return _strings.size(); }
+
+private:
+    // Nodes of std::unordered_map never move, so the keys can be handed out.
+    using Strings = std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>>;
+
+    Strings                                             _strings;  // Value to reference count.
+    std::unordered_map<RE::Setting*, Strings::iterator> _owners;   // Setting to the value it uses.
+};
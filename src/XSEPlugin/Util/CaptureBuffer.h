@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+#include <thread>
+
+/// Fixed-size text buffer that any number of threads can append to without
+/// locking or allocating. Text that does not fit is dropped, and the buffer
+/// remembers that it was truncated. It is not a ring: the oldest text is kept,
+/// because the first errors of a load usually explain the ones after them.
+template <std::size_t N>
+class CaptureBuffer
+{
+public:
+    /// Append all parts as one contiguous record. Never blocks.
+    void Append(std::initializer_list<std::string_view> a_parts) noexcept
+    {
+        std::size_t size = 0;
+        for (auto part : a_parts) {
+            size += part.size();
+        }
+
+        const auto pos = _reserved.fetch_add(size, std::memory_order_relaxed);
+        if (pos >= N) {
+            return;
+        }
+
+        const auto end = std::min(pos + size, N);
+        auto       cur = pos;
+        for (auto part : a_parts) {
+            const auto len = std::min(part.size(), end - cur);
+            std::memcpy(_data.data() + cur, part.data(), len);
+            cur += len;
+        }
+        _committed.fetch_add(end - pos, std::memory_order_release);
+    }
+
+    /// Append the text of `a_other`, which nothing appends to any more. If it
+    /// was truncated, so is this buffer.
+    void Append(const CaptureBuffer& a_other) noexcept
+    {
+        const auto reserved = a_other._reserved.load(std::memory_order_acquire);
+        Append({ std::string_view{ a_other._data.data(), std::min(reserved, N) } });
+        if (reserved > N) {
+            _reserved.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Forget all text. Must not race with Append.
+    void Clear() noexcept
+    {
+        _reserved.store(0, std::memory_order_relaxed);
+        _committed.store(0, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool truncated() const noexcept { return _reserved.load(std::memory_order_relaxed) > N; }
+
+    /// Copy the text to `a_dst`, which holds `a_len` bytes, and terminate it
+    /// with NUL. If the text was truncated here or does not fit, its end is
+    /// replaced by `a_marker`.
+    void CopyTo(char* a_dst, std::size_t a_len, std::string_view a_marker) const noexcept
+    {
+        if (!a_dst || a_len == 0) {
+            return;
+        }
+
+        const auto reserved = _reserved.load(std::memory_order_acquire);
+        const auto size = std::min(reserved, N);
+        while (_committed.load(std::memory_order_acquire) < size) {
+            std::this_thread::yield();  // An append is still copying.
+        }
+
+        const auto room = a_len - 1;
+        auto       len = std::min(size, room);
+        if (reserved > N || size > room) {
+            const auto mark = std::min(a_marker.size(), room);
+            len = std::min(len, room - mark);
+            std::memcpy(a_dst + len, a_marker.data(), mark);
+            std::memcpy(a_dst, _data.data(), len);
+            a_dst[len + mark] = '\0';
+        } else {
+            std::memcpy(a_dst, _data.data(), len);
+            a_dst[len] = '\0';
+        }
+    }
+
+private:
+    std::array<char, N>      _data;
+    std::atomic<std::size_t> _reserved{ 0 };
+    std::atomic<std::size_t> _committed{ 0 };
+};
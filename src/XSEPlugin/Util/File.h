@@ -0,0 +1,53 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+class FileError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+[[nodiscard]] inline std::string ReadFile(const std::filesystem::path& a_path)
+{
+    const auto size = static_cast<std::size_t>(std::filesystem::file_size(a_path));
+    std::string data(size, '\0');
+
+    if (std::ifstream file{ a_path, std::ios_base::in | std::ios_base::binary }) {
+        file.read(data.data(), static_cast<std::streamsize>(size));
+        data.resize(static_cast<std::size_t>(file.gcount()));
+    } else {
+        throw FileError("File could not be opened for reading");
+    }
+    return data;
+}
+
+[[nodiscard]] inline std::string ReadFile(const std::string& a_path) = delete;
+[[nodiscard]] inline std::string ReadFile(std::string_view a_path) = delete;
+[[nodiscard]] inline std::string ReadFile(const char* a_path) = delete;
+
+inline void WriteFileAtomic(const std::filesystem::path& a_path, std::string_view a_data)
+{
+    // Write next to the target, then swap it in, so readers never see a torn file.
+    auto tmp = a_path;
+    tmp += L".tmp";
+
+    if (std::ofstream file{ tmp, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc }) {
+        file.write(a_data.data(), static_cast<std::streamsize>(a_data.size()));
+        if (!file.flush()) {
+            throw FileError("File could not be written");
+        }
+    } else {
+        throw FileError("File could not be opened for writing");
+    }
+    std::filesystem::rename(tmp, a_path);
+}
+
+inline void WriteFileAtomic(const std::string& a_path, std::string_view a_data) = delete;
+inline void WriteFileAtomic(std::string_view a_path, std::string_view a_data) = delete;
+inline void WriteFileAtomic(const char* a_path, std::string_view a_data) = delete;
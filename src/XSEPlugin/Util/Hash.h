@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/// 64-bit FNV-1a hash. Used for content fingerprints, not for security.
+class Hash64
+{
+public:
+    constexpr Hash64() noexcept = default;
+
+    constexpr Hash64& Update(std::span<const std::byte> a_data) noexcept
+    {
+        for (auto b : a_data) {
+            _value = (_value ^ static_cast<std::uint64_t>(b)) * kPrime;
+        }
+        return *this;
+    }
+
+    constexpr Hash64& Update(std::string_view a_data) noexcept
+    {
+        for (auto c : a_data) {
+            _value = (_value ^ static_cast<std::uint8_t>(c)) * kPrime;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t value() const noexcept { return _value; }
+
+private:
+    static constexpr std::uint64_t kOffsetBasis = 0xCBF29CE484222325ull;
+    static constexpr std::uint64_t kPrime = 0x00000100000001B3ull;
+
+    std::uint64_t _value{ kOffsetBasis };
+};
+
+[[nodiscard]] constexpr std::uint64_t HashBytes(std::string_view a_data) noexcept
+{
+    return Hash64{}.Update(a_data).value();
+}
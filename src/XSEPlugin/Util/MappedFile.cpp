@@ -0,0 +1,178 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <system_error>
+
+#ifdef _WIN32
+#    include <Windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+    [[noreturn]] inline void ThrowLastError(const char* a_what)
+    {
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), a_what);
+    }
+
+    class Handle
+    {
+    public:
+        explicit Handle(HANDLE a_handle) noexcept :
+            _handle(a_handle)
+        {}
+
+        ~Handle() noexcept
+        {
+            if (_handle && _handle != INVALID_HANDLE_VALUE) {
+                CloseHandle(_handle);
+            }
+        }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        [[nodiscard]] HANDLE get() const noexcept { return _handle; }
+        [[nodiscard]] bool   valid() const noexcept { return _handle && _handle != INVALID_HANDLE_VALUE; }
+
+    private:
+        HANDLE _handle;
+    };
+
+    inline void ReadAll(HANDLE a_file, std::string& a_buffer)
+    {
+        char buffer[4096];
+        for (;;) {
+            DWORD read = 0;
+            if (!ReadFile(a_file, buffer, sizeof(buffer), &read, nullptr)) {
+                ThrowLastError("File could not be read");
+            }
+            if (read == 0) {
+                return;
+            }
+            a_buffer.append(buffer, read);
+        }
+    }
+#else
+    [[noreturn]] inline void ThrowErrno(const char* a_what)
+    {
+        throw std::system_error(errno, std::generic_category(), a_what);
+    }
+
+    class FileDescriptor
+    {
+    public:
+        explicit FileDescriptor(int a_fd) noexcept :
+            _fd(a_fd)
+        {}
+
+        ~FileDescriptor() noexcept
+        {
+            if (_fd >= 0) {
+                ::close(_fd);
+            }
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        [[nodiscard]] int  get() const noexcept { return _fd; }
+        [[nodiscard]] bool valid() const noexcept { return _fd >= 0; }
+
+    private:
+        int _fd;
+    };
+
+    inline void ReadAll(int a_fd, std::string& a_buffer)
+    {
+        char buffer[4096];
+        for (;;) {
+            const auto read = ::read(a_fd, buffer, sizeof(buffer));
+            if (read < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowErrno("File could not be read");
+            }
+            if (read == 0) {
+                return;
+            }
+            a_buffer.append(buffer, static_cast<std::size_t>(read));
+        }
+    }
+#endif
+}
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::filesystem::path& a_path)
+{
+    // Let editors keep writing, renaming and deleting the file while it is read.
+    Handle file{ CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+    if (!file.valid()) {
+        ThrowLastError("File could not be opened for reading");
+    }
+
+    LARGE_INTEGER size{};
+    if (GetFileType(file.get()) != FILE_TYPE_DISK || !GetFileSizeEx(file.get(), &size) || size.QuadPart == 0) {
+        ReadAll(file.get(), _buffer);
+        return;
+    }
+
+    // The view keeps the mapping alive, so both handles can be closed here.
+    Handle mapping{ CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    if (!mapping.valid()) {
+        ThrowLastError("File could not be mapped");
+    }
+
+    _mapping = static_cast<const char*>(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0));
+    if (!_mapping) {
+        ThrowLastError("File could not be mapped");
+    }
+    _size = static_cast<std::size_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    if (_mapping) {
+        UnmapViewOfFile(_mapping);
+    }
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& a_path)
+{
+    FileDescriptor file{ ::open(a_path.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (!file.valid()) {
+        ThrowErrno("File could not be opened for reading");
+    }
+
+    struct stat st{};
+    if (::fstat(file.get(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        ReadAll(file.get(), _buffer);
+        return;
+    }
+
+    // The mapping holds its own reference to the file, so the descriptor can be closed here.
+    const auto size = static_cast<std::size_t>(st.st_size);
+    auto       mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.get(), 0);
+    if (mapping == MAP_FAILED) {
+        ThrowErrno("File could not be mapped");
+    }
+    ::posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+
+    _mapping = static_cast<const char*>(mapping);
+    _size = size;
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    if (_mapping) {
+        ::munmap(const_cast<char*>(_mapping), _size);
+    }
+}
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+/// Read-only view of the whole content of a file. Regular files are mapped
+/// into memory, so that nothing is copied; empty and special files, which
+/// cannot be mapped, are read into a buffer instead.
+///
+/// Keep the view short-lived: while a file is mapped, Windows refuses to
+/// truncate it, and on POSIX truncating it makes reading the view fault.
+class MappedFile
+{
+public:
+    /// Throws `std::system_error` if the file cannot be opened or read.
+    explicit MappedFile(const std::filesystem::path& a_path);
+    explicit MappedFile(const std::string& a_path) = delete;
+    explicit MappedFile(std::string_view a_path) = delete;
+    explicit MappedFile(const char* a_path) = delete;
+
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::string_view view() const noexcept
+    {
+        return _mapping ? std::string_view{ _mapping, _size } : std::string_view{ _buffer };
+    }
+
+    [[nodiscard]] bool mapped() const noexcept { return _mapping != nullptr; }
+
+private:
+    const char* _mapping{ nullptr };
+    std::size_t _size{ 0 };
+    std::string _buffer;
+};
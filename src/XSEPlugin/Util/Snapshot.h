@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+/// An immutable value that is replaced as a whole. Readers take a reference to
+/// the current value and keep it alive for as long as they hold it, so a reader
+/// never waits for a writer to build the next value, and only ever sees the old
+/// value or the new one.
+///
+/// Load and Publish are not lock-free: both MSVC and libstdc++ guard the
+/// pointer with a short internal lock, held only to copy or swap it.
+template <class T>
+class Snapshot
+{
+public:
+    using Pointer = std::shared_ptr<const T>;
+
+    explicit Snapshot(Pointer a_value = std::make_shared<const T>()) noexcept :
+        _value(std::move(a_value))
+    {}
+
+    /// The current value. Safe to call from any thread.
+    [[nodiscard]] Pointer Load() const noexcept { return _value.load(std::memory_order_acquire); }
+
+    /// Replace the value. Readers that still hold the old one keep it until
+    /// they let go. Safe to call from any thread.
+    void Publish(Pointer a_value) noexcept { _value.store(std::move(a_value), std::memory_order_release); }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+private:
+    std::atomic<Pointer> _value;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/// ASCII lower case, which is how the game compares setting names.
+[[nodiscard]] constexpr char ToLowerASCII(char a_ch) noexcept
+{
+    return (a_ch >= 'A' && a_ch <= 'Z') ? static_cast<char>(a_ch - 'A' + 'a') : a_ch;
+}
+
+/// Transparent hash, so that maps keyed by std::string can be searched with
+/// std::string_view without allocating.
+struct StringHash
+{
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(std::string_view a_str) const noexcept
+    {
+        return std::hash<std::string_view>{}(a_str);
+    }
+};
+
+struct CaseInsensitiveHash
+{
+    using is_transparent = void;
+
+    [[nodiscard]] constexpr std::size_t operator()(std::string_view a_str) const noexcept
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (auto c : a_str) {
+            hash = (hash ^ static_cast<std::uint8_t>(ToLowerASCII(c))) * 0x00000100000001B3ull;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+};
+
+struct CaseInsensitiveEqual
+{
+    using is_transparent = void;
+
+    [[nodiscard]] constexpr bool operator()(std::string_view a_lhs, std::string_view a_rhs) const noexcept
+    {
+        return std::ranges::equal(a_lhs, a_rhs,
+            [](char a_l, char a_r) { return ToLowerASCII(a_l) == ToLowerASCII(a_r); });
+    }
+};
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <expected>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <ios>
-#include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -14,6 +16,8 @@
 
 #include <toml++/toml.hpp>
 
+#include <XSEPlugin/Util/MappedFile.h>
+
 template <class T>
 concept TOMLScalar = std::is_arithmetic_v<T> || std::is_same_v<T, std::string>;
 
@@ -23,19 +27,96 @@ public:
     using std::runtime_error::runtime_error;
 };
 
-[[nodiscard]] inline toml::table LoadTOMLFile(const std::filesystem::path& a_path)
+enum class TOMLErrorCode : std::uint8_t
 {
-    const auto size = static_cast<std::size_t>(std::filesystem::file_size(a_path));
-    const auto data = std::make_unique_for_overwrite<char[]>(size);
+    kRequired,
+    kNotSection,
+    kNotArray,
+    kNotBool,
+    kNotInteger,
+    kNotFloat,
+    kNotString,
+    kInvalid,  // Of the right type, but out of range.
+};
 
-    if (std::ifstream file{ a_path, std::ios_base::in | std::ios_base::binary }) {
-        file.read(data.get(), static_cast<std::streamsize>(size));
-    } else {
-        throw TOMLError("File could not be opened for reading");
+/// What is wrong with one key, as returned by the TryGet functions. Only a
+/// code and views are kept; the message is formatted when it is asked for.
+struct TOMLIssue
+{
+    TOMLErrorCode    code;
+    std::string_view key;        // The key passed by the caller.
+    std::string_view section{};  // Set by TOMLIssues::Check.
+    bool             element{ false };  // Whether an element of an array has the wrong type.
+
+    [[nodiscard]] std::string message() const
+    {
+        const auto name = section.empty() ? std::format("'{}'", key) : std::format("'{}.{}'", section, key);
+        const auto a = element ? "an array of " : "a ";
+        const auto an = element ? "an array of " : "an ";
+        switch (code) {
+        case TOMLErrorCode::kRequired:
+            return std::format("{} is required", name);
+        case TOMLErrorCode::kNotSection:
+            return std::format("{} is not a section", name);
+        case TOMLErrorCode::kNotArray:
+            return std::format("{} is not an array", name);
+        case TOMLErrorCode::kNotBool:
+            return std::format("{} is not {}bool", name, a);
+        case TOMLErrorCode::kNotInteger:
+            return std::format("{} is not {}integer", name, an);
+        case TOMLErrorCode::kNotFloat:
+            return std::format("{} is not {}float", name, a);
+        case TOMLErrorCode::kNotString:
+            return std::format("{} is not {}string", name, a);
+        default:
+            return element ? std::format("Invalid element of array {}", name) : std::format("Invalid {}", name);
+        }
+    }
+};
+
+/// Collects the issues of a whole file, so that all of them are reported at
+/// once instead of only the first.
+class TOMLIssues
+{
+public:
+    /// Record the issue of `a_result`, if any, as one of `a_section`. Return
+    /// whether there was none.
+    template <class T>
+    bool Check(const std::expected<T, TOMLIssue>& a_result, std::string_view a_section = {})
+    {
+        if (a_result) {
+            return true;
+        }
+        auto& issue = _issues.emplace_back(a_result.error());
+        issue.section = a_section;
+        return false;
     }
 
-    std::string_view doc{ data.get(), size };
-    return toml::parse(doc, a_path.native());
+    [[nodiscard]] bool                       empty() const noexcept { return _issues.empty(); }
+    [[nodiscard]] std::span<const TOMLIssue> issues() const noexcept { return _issues; }
+
+    /// All messages, separated by `a_separator`.
+    [[nodiscard]] std::string message(std::string_view a_separator = "; ") const
+    {
+        std::string result;
+        for (const auto& issue : _issues) {
+            if (!result.empty()) {
+                result += a_separator;
+            }
+            result += issue.message();
+        }
+        return result;
+    }
+
+private:
+    std::vector<TOMLIssue> _issues;
+};
+
+[[nodiscard]] inline toml::table LoadTOMLFile(const std::filesystem::path& a_path)
+{
+    // Parse straight from the mapped pages; the table copies what it keeps.
+    const MappedFile file{ a_path };
+    return toml::parse(file.view(), a_path.native());
 }
 
 [[nodiscard]] inline toml::table LoadTOMLFile(const std::string& a_path) = delete;
@@ -56,12 +137,13 @@ inline void SaveTOMLFile(std::string_view a_path, const toml::table& a_table) =
 inline void SaveTOMLFile(const char* a_path, const toml::table& a_table) = delete;
 
 template <bool required = false>
-[[nodiscard]] inline const toml::table* GetTOMLSection(const toml::table& a_table, std::string_view a_key)
+[[nodiscard]] inline std::expected<const toml::table*, TOMLIssue> TryGetTOMLSection(const toml::table& a_table,
+    std::string_view a_key) noexcept
 {
     auto node = a_table.get(a_key);
     if (!node) {
         if constexpr (required) {
-            throw TOMLError(std::format("'{}' is required", a_key));
+            return std::unexpected(TOMLIssue{ TOMLErrorCode::kRequired, a_key });
         } else {
             return nullptr;
         }
@@ -69,11 +151,21 @@ template <bool required = false>
 
     auto section = node->as_table();
     if (!section) {
-        throw TOMLError(std::format("'{}' is not a section", a_key));
+        return std::unexpected(TOMLIssue{ TOMLErrorCode::kNotSection, a_key });
     }
     return section;
 }
 
+template <bool required = false>
+[[nodiscard]] inline const toml::table* GetTOMLSection(const toml::table& a_table, std::string_view a_key)
+{
+    auto section = TryGetTOMLSection<required>(a_table, a_key);
+    if (!section) {
+        throw TOMLError(section.error().message());
+    }
+    return *section;
+}
+
 [[nodiscard]] inline const toml::table* GetTOMLSectionRequired(const toml::table& a_table, std::string_view a_key)
 {
     return GetTOMLSection<true>(a_table, a_key);
@@ -87,84 +179,93 @@ inline void SetTOMLSection(toml::table& a_table, std::string_view a_key, toml::t
     }
 }
 
+namespace TOMLDetail
+{
+    /// Why `a_node` has no value of type T.
+    template <TOMLScalar T>
+    [[nodiscard]] inline TOMLErrorCode TypeError(const toml::node& a_node) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return a_node.is_boolean() ? TOMLErrorCode::kInvalid : TOMLErrorCode::kNotBool;
+        } else if constexpr (std::is_integral_v<T>) {
+            return a_node.is_integer() ? TOMLErrorCode::kInvalid : TOMLErrorCode::kNotInteger;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return a_node.is_floating_point() ? TOMLErrorCode::kInvalid : TOMLErrorCode::kNotFloat;
+        } else {
+            return a_node.is_string() ? TOMLErrorCode::kInvalid : TOMLErrorCode::kNotString;
+        }
+    }
+}
+
+/// Read `a_key` into `a_target`, which is left unchanged if the key is missing
+/// and not required, or if it is invalid.
 template <TOMLScalar T, bool required = false>
-inline void GetTOMLValue(const toml::table& a_table, std::string_view a_key, T& a_target)
+[[nodiscard]] inline std::expected<void, TOMLIssue> TryGetTOMLValue(const toml::table& a_table,
+    std::string_view a_key, T& a_target)
 {
     auto node = a_table.get(a_key);
     if (!node) {
         if constexpr (required) {
-            throw TOMLError(std::format("'{}' is required", a_key));
+            return std::unexpected(TOMLIssue{ TOMLErrorCode::kRequired, a_key });
         } else {
-            return;  // Leave target unchanged.
+            return {};
         }
     }
 
     auto value = node->value<T>();
     if (!value) {
-        if constexpr (std::is_same_v<T, bool>) {
-            if (!node->is_boolean()) {
-                throw TOMLError(std::format("'{}' is not a bool", a_key));
-            }
-        } else if constexpr (std::is_integral_v<T>) {
-            if (!node->is_integer()) {
-                throw TOMLError(std::format("'{}' is not an integer", a_key));
-            }
-        } else if constexpr (std::is_floating_point_v<T>) {
-            if (!node->is_floating_point()) {
-                throw TOMLError(std::format("'{}' is not a float", a_key));
-            }
-        } else if constexpr (std::is_same_v<T, std::string>) {
-            if (!node->is_string()) {
-                throw TOMLError(std::format("'{}' is not a string", a_key));
-            }
-        }
-        throw TOMLError(std::format("Invalid '{}'", a_key));
+        return std::unexpected(TOMLIssue{ TOMLDetail::TypeError<T>(*node), a_key });
     }
     a_target = *std::move(value);
+    return {};
 }
 
+/// Read the array `a_key` into `a_target`, which is left unchanged if the key
+/// is missing and not required, or if any element is invalid.
 template <TOMLScalar T, bool required = false>
-inline void GetTOMLValue(const toml::table& a_table, std::string_view a_key, std::vector<T>& a_target)
+[[nodiscard]] inline std::expected<void, TOMLIssue> TryGetTOMLValue(const toml::table& a_table,
+    std::string_view a_key, std::vector<T>& a_target)
 {
     auto node = a_table.get(a_key);
     if (!node) {
         if constexpr (required) {
-            throw TOMLError(std::format("'{}' is required", a_key));
+            return std::unexpected(TOMLIssue{ TOMLErrorCode::kRequired, a_key });
         } else {
-            return;  // Leave target unchanged.
+            return {};
         }
     }
 
     auto arr = node->as_array();
     if (!arr) {
-        throw TOMLError(std::format("'{}' is not an array", a_key));
+        return std::unexpected(TOMLIssue{ TOMLErrorCode::kNotArray, a_key });
     }
 
-    a_target.clear();
-    a_target.reserve(arr->size());
+    std::vector<T> values;
+    values.reserve(arr->size());
     for (const auto& ele : *arr) {
         auto value = ele.value<T>();
         if (!value) {
-            if constexpr (std::is_same_v<T, bool>) {
-                if (!node->is_boolean()) {
-                    throw TOMLError(std::format("'{}' is not an array of bool", a_key));
-                }
-            } else if constexpr (std::is_integral_v<T>) {
-                if (!node->is_integer()) {
-                    throw TOMLError(std::format("'{}' is not an array of integer", a_key));
-                }
-            } else if constexpr (std::is_floating_point_v<T>) {
-                if (!node->is_floating_point()) {
-                    throw TOMLError(std::format("'{}' is not an array of float", a_key));
-                }
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                if (!node->is_string()) {
-                    throw TOMLError(std::format("'{}' is not an array of string", a_key));
-                }
-            }
-            throw TOMLError(std::format("Invalid '{}'", a_key));
+            return std::unexpected(TOMLIssue{ TOMLDetail::TypeError<T>(ele), a_key, {}, true });
         }
-        a_target.push_back(*std::move(value));
+        values.push_back(*std::move(value));
+    }
+    a_target = std::move(values);
+    return {};
+}
+
+template <TOMLScalar T, bool required = false>
+inline void GetTOMLValue(const toml::table& a_table, std::string_view a_key, T& a_target)
+{
+    if (auto result = TryGetTOMLValue<T, required>(a_table, a_key, a_target); !result) {
+        throw TOMLError(result.error().message());
+    }
+}
+
+template <TOMLScalar T, bool required = false>
+inline void GetTOMLValue(const toml::table& a_table, std::string_view a_key, std::vector<T>& a_target)
+{
+    if (auto result = TryGetTOMLValue<T, required>(a_table, a_key, a_target); !result) {
+        throw TOMLError(result.error().message());
     }
 }
 
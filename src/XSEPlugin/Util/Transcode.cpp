@@ -0,0 +1,225 @@
+#include "Transcode.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#    include <emmintrin.h>
+#    define TRANSCODE_SSE2
+#endif
+
+namespace
+{
+    [[nodiscard]] constexpr bool IsHighSurrogate(char32_t a_unit) noexcept
+    {
+        return a_unit >= 0xD800 && a_unit < 0xDC00;
+    }
+
+    [[nodiscard]] constexpr bool IsLowSurrogate(char32_t a_unit) noexcept
+    {
+        return a_unit >= 0xDC00 && a_unit < 0xE000;
+    }
+
+    [[nodiscard]] constexpr bool IsContinuation(unsigned char a_byte) noexcept { return (a_byte & 0xC0) == 0x80; }
+}
+
+std::optional<std::size_t> Utf16ToUtf8(std::u16string_view a_in, std::span<char> a_out) noexcept
+{
+    auto       src = a_in.data();
+    const auto srcEnd = src + a_in.size();
+    auto       dst = a_out.data();
+    const auto dstEnd = dst + a_out.size();
+
+    while (src != srcEnd) {
+#ifdef TRANSCODE_SSE2
+        // Eight ASCII units at a time, narrowed by saturation, which keeps them as they are.
+        const auto nonASCII = _mm_set1_epi16(static_cast<short>(0xFF80));
+        while (srcEnd - src >= 8 && dstEnd - dst >= 8) {
+            const auto units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, nonASCII), _mm_setzero_si128())) != 0xFFFF) {
+                break;
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(units, units));
+            src += 8;
+            dst += 8;
+        }
+        if (src == srcEnd) {
+            break;
+        }
+#endif
+
+        char32_t cp = *src++;
+        if (IsHighSurrogate(cp)) {
+            if (src == srcEnd || !IsLowSurrogate(*src)) {
+                return std::nullopt;
+            }
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (*src++ - 0xDC00);
+        } else if (IsLowSurrogate(cp)) {
+            return std::nullopt;
+        }
+
+        const auto size = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+        if (dstEnd - dst < size) {
+            return std::nullopt;
+        }
+        switch (size) {
+        case 1:
+            *dst++ = static_cast<char>(cp);
+            break;
+        case 2:
+            *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+            break;
+        case 3:
+            *dst++ = static_cast<char>(0xE0 | (cp >> 12));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+            break;
+        default:
+            *dst++ = static_cast<char>(0xF0 | (cp >> 18));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+            break;
+        }
+    }
+    return static_cast<std::size_t>(dst - a_out.data());
+}
+
+std::optional<std::size_t> Utf8ToUtf16(std::string_view a_in, std::span<char16_t> a_out) noexcept
+{
+    auto       src = reinterpret_cast<const unsigned char*>(a_in.data());
+    const auto srcEnd = src + a_in.size();
+    auto       dst = a_out.data();
+    const auto dstEnd = dst + a_out.size();
+
+    while (src != srcEnd) {
+#ifdef TRANSCODE_SSE2
+        // Sixteen ASCII bytes at a time, widened by interleaving with zeros.
+        while (srcEnd - src >= 16 && dstEnd - dst >= 16) {
+            const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            if (_mm_movemask_epi8(bytes) != 0) {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(bytes, _mm_setzero_si128()));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_unpackhi_epi8(bytes, _mm_setzero_si128()));
+            src += 16;
+            dst += 16;
+        }
+        if (src == srcEnd) {
+            break;
+        }
+#endif
+
+        const auto lead = *src++;
+        char32_t   cp;
+        int        trail;
+        char32_t   min;
+        if (lead < 0x80) {
+            cp = lead;
+            trail = 0;
+            min = 0;
+        } else if ((lead & 0xE0) == 0xC0) {
+            cp = lead & 0x1F;
+            trail = 1;
+            min = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+            cp = lead & 0x0F;
+            trail = 2;
+            min = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+            cp = lead & 0x07;
+            trail = 3;
+            min = 0x10000;
+        } else {
+            return std::nullopt;
+        }
+
+        if (srcEnd - src < trail) {
+            return std::nullopt;
+        }
+        for (int i = 0; i < trail; ++i) {
+            if (!IsContinuation(*src)) {
+                return std::nullopt;
+            }
+            cp = (cp << 6) | (*src++ & 0x3F);
+        }
+
+        // Overlong forms, surrogates and values past Unicode are malformed.
+        if (cp < min || cp > 0x10FFFF || IsHighSurrogate(cp) || IsLowSurrogate(cp)) {
+            return std::nullopt;
+        }
+
+        if (cp < 0x10000) {
+            if (dst == dstEnd) {
+                return std::nullopt;
+            }
+            *dst++ = static_cast<char16_t>(cp);
+        } else {
+            if (dstEnd - dst < 2) {
+                return std::nullopt;
+            }
+            cp -= 0x10000;
+            *dst++ = static_cast<char16_t>(0xD800 + (cp >> 10));
+            *dst++ = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+        }
+    }
+    return static_cast<std::size_t>(dst - a_out.data());
+}
+
+std::optional<std::string> Utf16ToUtf8(std::u16string_view a_in)
+{
+    std::string out(MaxUtf8Size(a_in.size()), '\0');
+    auto        size = Utf16ToUtf8(a_in, out);
+    if (!size) {
+        return std::nullopt;
+    }
+    out.resize(*size);
+    return out;
+}
+
+std::optional<std::u16string> Utf8ToUtf16(std::string_view a_in)
+{
+    std::u16string out(MaxUtf16Size(a_in.size()), u'\0');
+    auto           size = Utf8ToUtf16(a_in, out);
+    if (!size) {
+        return std::nullopt;
+    }
+    out.resize(*size);
+    return out;
+}
+
+std::string Utf16ToUtf8Lossy(std::u16string_view a_in)
+{
+    // Nearly every name is valid, and takes the fast path.
+    if (auto out = Utf16ToUtf8(a_in)) {
+        return *std::move(out);
+    }
+
+    // U+FFFD takes three bytes, as much as the unit it replaces may.
+    std::string out(MaxUtf8Size(a_in.size()), '\0');
+    auto        dst = out.data();
+    for (std::size_t i = 0; i < a_in.size(); ++i) {
+        char32_t cp = a_in[i];
+        if (IsHighSurrogate(cp) && i + 1 < a_in.size() && IsLowSurrogate(a_in[i + 1])) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (a_in[++i] - 0xDC00);
+        } else if (IsHighSurrogate(cp) || IsLowSurrogate(cp)) {
+            cp = 0xFFFD;
+        }
+
+        if (cp < 0x80) {
+            *dst++ = static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            *dst++ = static_cast<char>(0xE0 | (cp >> 12));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            *dst++ = static_cast<char>(0xF0 | (cp >> 18));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+    out.resize(static_cast<std::size_t>(dst - out.data()));
+    return out;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Conversion between UTF-8 and UTF-16 into buffers of the caller. Runs of
+// ASCII, which is nearly every path and setting name, are copied a whole
+// vector at a time. Malformed input is rejected rather than replaced.
+
+/// Largest UTF-8 size of `a_size` UTF-16 code units.
+[[nodiscard]] constexpr std::size_t MaxUtf8Size(std::size_t a_size) noexcept
+{
+    return a_size * 3;
+}
+
+/// Largest UTF-16 size of `a_size` bytes of UTF-8.
+[[nodiscard]] constexpr std::size_t MaxUtf16Size(std::size_t a_size) noexcept
+{
+    return a_size;
+}
+
+/// Convert `a_in` into `a_out`, and return the number of bytes written, or
+/// nothing if `a_in` is malformed or `a_out` is too small.
+[[nodiscard]] std::optional<std::size_t> Utf16ToUtf8(std::u16string_view a_in, std::span<char> a_out) noexcept;
+
+/// Convert `a_in` into `a_out`, and return the number of code units written,
+/// or nothing if `a_in` is malformed or `a_out` is too small.
+[[nodiscard]] std::optional<std::size_t> Utf8ToUtf16(std::string_view a_in, std::span<char16_t> a_out) noexcept;
+
+[[nodiscard]] std::optional<std::string>    Utf16ToUtf8(std::u16string_view a_in);
+[[nodiscard]] std::optional<std::u16string> Utf8ToUtf16(std::string_view a_in);
+
+/// Convert `a_in`, replacing each unpaired surrogate with U+FFFD, as Windows
+/// does for file names that are not valid UTF-16.
+[[nodiscard]] std::string Utf16ToUtf8Lossy(std::u16string_view a_in);
+
+#ifdef _WIN32
+[[nodiscard]] inline std::u16string_view AsUtf16(std::wstring_view a_str) noexcept
+{
+    static_assert(sizeof(wchar_t) == sizeof(char16_t));
+    return { reinterpret_cast<const char16_t*>(a_str.data()), a_str.size() };
+}
+#endif
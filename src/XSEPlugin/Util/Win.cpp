@@ -32,4 +32,52 @@ namespace Win
         }
         return OsVersion{ ovi.dwMajorVersion, ovi.dwMinorVersion, ovi.dwBuildNumber };
     }
+
+    DirectoryMonitor::DirectoryMonitor(const std::filesystem::path& a_path)
+    {
+        _change = FindFirstChangeNotificationW(a_path.c_str(), TRUE,
+            FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+        if (_change == INVALID_HANDLE_VALUE) {
+            _change = nullptr;
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(),
+                "FindFirstChangeNotificationW");
+        }
+
+        _cancel = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!_cancel) {
+            auto err = static_cast<int>(GetLastError());
+            FindCloseChangeNotification(_change);
+            throw std::system_error(err, std::system_category(), "CreateEventW");
+        }
+    }
+
+    DirectoryMonitor::~DirectoryMonitor() noexcept
+    {
+        FindCloseChangeNotification(_change);
+        CloseHandle(_cancel);
+    }
+
+    DirectoryMonitor::Result DirectoryMonitor::Wait(std::optional<std::chrono::milliseconds> a_timeout) noexcept
+    {
+        const HANDLE handles[] = { _cancel, _change };
+        const DWORD  timeout = a_timeout ? static_cast<DWORD>(a_timeout->count()) : INFINITE;
+
+        switch (WaitForMultipleObjects(2, handles, FALSE, timeout)) {
+        case WAIT_OBJECT_0 + 1:
+            // Rearm before returning so that nothing is missed while the caller works.
+            if (!FindNextChangeNotification(_change)) {
+                return Result::kCancelled;
+            }
+            return Result::kChanged;
+        case WAIT_TIMEOUT:
+            return Result::kTimeout;
+        default:
+            return Result::kCancelled;
+        }
+    }
+
+    void DirectoryMonitor::Cancel() noexcept
+    {
+        SetEvent(_cancel);
+    }
 }
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <chrono>
 #include <compare>
 #include <cstdint>
+#include <filesystem>
 #include <format>
 #include <optional>
 #include <string>
@@ -54,4 +56,34 @@ namespace Win
         std::uint32_t _minor;
         std::uint32_t _build;
     };
+
+    /// Blocks until files in a directory or its subdirectories change, using
+    /// file system notifications, so that waiting costs no CPU.
+    class DirectoryMonitor
+    {
+    public:
+        enum class Result
+        {
+            kChanged,
+            kTimeout,
+            kCancelled,
+        };
+
+        /// Throws `std::system_error` if the directory cannot be watched.
+        explicit DirectoryMonitor(const std::filesystem::path& a_path);
+        ~DirectoryMonitor() noexcept;
+
+        DirectoryMonitor(const DirectoryMonitor&) = delete;
+        DirectoryMonitor& operator=(const DirectoryMonitor&) = delete;
+
+        /// Wait for a change, for `a_timeout` if given, or until Cancel is called.
+        [[nodiscard]] Result Wait(std::optional<std::chrono::milliseconds> a_timeout) noexcept;
+
+        /// Wake up Wait for good. May be called from any thread.
+        void Cancel() noexcept;
+
+    private:
+        void* _change{ nullptr };
+        void* _cancel{ nullptr };
+    };
 }
@@ -0,0 +1,56 @@
+#include "Watchdog.h"
+
+#include <XSEPlugin/Configuration.h>
+#include <XSEPlugin/GameSettings.h>
+
+namespace
+{
+    inline Configuration::Watchdog GetConfig()
+    {
+        auto lock = Configuration::LockShared();
+        return Configuration::GetSingleton()->watchdog;
+    }
+
+    /// Run a check on the main thread, unless one is already queued.
+    inline void QueueCheck(bool a_reassert)
+    {
+        static std::atomic_bool queued{ false };
+
+        if (queued.exchange(true)) {
+            return;
+        }
+        SKSE::GetTaskInterface()->AddTask([a_reassert]() {
+            queued = false;
+            GameSettings::CheckDrift(a_reassert);
+        });
+    }
+}
+
+void Watchdog::Start()
+{
+    static std::jthread timer;
+
+    const auto config = GetConfig();
+    if (!config.enable || config.interval == 0 || timer.joinable()) {
+        return;
+    }
+
+    timer = std::jthread{ [config](std::stop_token a_stop) {
+        std::mutex                  lock;
+        std::condition_variable_any wake;
+        const auto                  interval = std::chrono::milliseconds{ config.interval };
+
+        std::unique_lock guard{ lock };
+        while (!wake.wait_for(guard, a_stop, interval, [&a_stop] { return a_stop.stop_requested(); })) {
+            QueueCheck(config.reassert);
+        }
+    } };
+    SKSE::log::info("Checking overridden settings for changes every {} ms.", config.interval);
+}
+
+void Watchdog::Check()
+{
+    if (const auto config = GetConfig(); config.enable) {
+        GameSettings::CheckDrift(config.reassert);
+    }
+}
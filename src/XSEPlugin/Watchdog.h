@@ -0,0 +1,12 @@
+#pragma once
+
+/// Checks that other mods have not changed the overridden settings.
+class Watchdog
+{
+public:
+    /// Start checking on the configured interval, if enabled in the configuration.
+    static void Start();
+
+    /// Check once, if enabled. Main thread only.
+    static void Check();
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <iostream>
+#include <source_location>
+
+// Just enough to report failed checks. Each test is its own executable, which
+// runs every check and exits with a failure if any of them failed.
+
+namespace Test
+{
+    inline int& GetFailures() noexcept
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline bool Check(bool a_ok, std::string_view a_what,
+        std::source_location a_location = std::source_location::current())
+    {
+        if (!a_ok) {
+            ++GetFailures();
+            std::cerr << a_location.file_name() << '(' << a_location.line() << "): " << a_what << '\n';
+        }
+        return a_ok;
+    }
+
+    [[nodiscard]] inline int Finish()
+    {
+        const auto failures = GetFailures();
+        if (failures != 0) {
+            std::cerr << failures << " checks failed.\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << "All checks passed.\n";
+        return EXIT_SUCCESS;
+    }
+}
@@ -0,0 +1,182 @@
+// Drives DirectoryWatcher with the polling backend over a scratch directory, and
+// checks that each burst of changes is reported once, after it has settled.
+
+#include <XSEPlugin/DirectoryWatcher.h>
+
+#include "Check.h"
+
+using Test::Check;
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr auto kInterval = 10ms;
+    constexpr auto kDebounce = 150ms;
+
+    /// Long enough for any change to be seen and settle on a busy machine.
+    constexpr auto kTimeout = 5s;
+
+    /// Counts the callbacks, and when the last one came.
+    class Recorder
+    {
+    public:
+        void OnChanged()
+        {
+            {
+                std::scoped_lock lock{ _mutex };
+                ++_count;
+                _last = std::chrono::steady_clock::now();
+            }
+            _cv.notify_all();
+        }
+
+        /// Wait until there were `a_count` callbacks in total.
+        [[nodiscard]] bool WaitFor(std::size_t a_count)
+        {
+            std::unique_lock lock{ _mutex };
+            return _cv.wait_for(lock, kTimeout, [&] { return _count >= a_count; });
+        }
+
+        [[nodiscard]] std::size_t GetCount()
+        {
+            std::scoped_lock lock{ _mutex };
+            return _count;
+        }
+
+        [[nodiscard]] std::chrono::steady_clock::time_point GetLast()
+        {
+            std::scoped_lock lock{ _mutex };
+            return _last;
+        }
+
+    private:
+        std::mutex                            _mutex;
+        std::condition_variable               _cv;
+        std::size_t                           _count{ 0 };
+        std::chrono::steady_clock::time_point _last;
+    };
+
+    void Write(const std::filesystem::path& a_path, std::string_view a_data)
+    {
+        std::ofstream file{ a_path, std::ios::binary | std::ios::trunc };
+        file << a_data;
+    }
+
+    /// Nothing more is reported once a burst has been.
+    void CheckQuiet(Recorder& a_recorder, std::size_t a_count, std::string_view a_what)
+    {
+        std::this_thread::sleep_for(3 * kDebounce);
+        Check(a_recorder.GetCount() == a_count, std::format("{}: reported more than once", a_what));
+    }
+
+    void Run(const std::filesystem::path& a_dir)
+    {
+        Recorder recorder;
+        auto     watcher = std::make_unique<DirectoryWatcher>(std::make_unique<PollingWatchBackend>(a_dir, kInterval),
+            kDebounce, [&] { recorder.OnChanged(); });
+
+        std::this_thread::sleep_for(3 * kDebounce);
+        Check(recorder.GetCount() == 0, "reported a change of an untouched directory");
+
+        std::size_t expected = 0;
+
+        // Create.
+        Write(a_dir / "a.toml", "fA = 1.0\n");
+        Check(recorder.WaitFor(++expected), "creating a file was not reported");
+        CheckQuiet(recorder, expected, "creating a file");
+
+        // Modify, several times within the debounce time, as editors do.
+        const auto burst = std::chrono::steady_clock::now();
+        for (int i = 0; i < 5; ++i) {
+            Write(a_dir / "a.toml", std::format("fA = {}.0\n{}", i, std::string(i, '#')));
+            std::this_thread::sleep_for(kDebounce / 3);
+        }
+        const auto settled = std::chrono::steady_clock::now();
+        Check(recorder.GetCount() == expected, "a burst was reported before it ended");
+        Check(recorder.WaitFor(++expected), "modifying a file was not reported");
+        Check(recorder.GetLast() >= settled, "a burst was reported before it ended");
+        Check(recorder.GetLast() - burst >= kDebounce, "a burst was reported without waiting for the debounce time");
+        CheckQuiet(recorder, expected, "modifying a file");
+
+        // Write a temporary file, rename it over the original and touch it.
+        Write(a_dir / "a.toml.tmp", "fA = 9.0\n");
+        std::filesystem::rename(a_dir / "a.toml.tmp", a_dir / "a.toml");
+        std::filesystem::last_write_time(a_dir / "a.toml", std::filesystem::file_time_type::clock::now() + 1s);
+        Check(recorder.WaitFor(++expected), "replacing a file was not reported");
+        CheckQuiet(recorder, expected, "replacing a file");
+
+        // Subdirectories are watched too.
+        std::filesystem::create_directories(a_dir / "Profiles" / "A");
+        Write(a_dir / "Profiles" / "A" / "b.toml", "iB = 2\n");
+        Check(recorder.WaitFor(++expected), "creating a file in a subdirectory was not reported");
+        CheckQuiet(recorder, expected, "creating a file in a subdirectory");
+
+        // Delete.
+        std::filesystem::remove(a_dir / "a.toml");
+        Check(recorder.WaitFor(++expected), "deleting a file was not reported");
+        CheckQuiet(recorder, expected, "deleting a file");
+
+        // A change that is undone within the debounce time still ends a burst.
+        Write(a_dir / "c.toml", "sC = \"c\"\n");
+        std::this_thread::sleep_for(kDebounce / 3);
+        std::filesystem::remove(a_dir / "c.toml");
+        Check(recorder.WaitFor(++expected), "a change undone within the debounce time was not reported");
+        CheckQuiet(recorder, expected, "a change undone within the debounce time");
+
+        // Stopping in the middle of a burst neither waits for it nor reports it.
+        Write(a_dir / "d.toml", "bD = true\n");
+        std::this_thread::sleep_for(kDebounce / 3);
+        const auto stop = std::chrono::steady_clock::now();
+        watcher.reset();
+        Check(std::chrono::steady_clock::now() - stop < kDebounce, "stopping waited for the burst to end");
+        Check(recorder.GetCount() == expected, "a burst was reported after stopping");
+    }
+
+    void TestThrowingCallback(const std::filesystem::path& a_dir)
+    {
+        // Whatever the callback throws, the watcher keeps running.
+        Recorder recorder;
+        {
+            DirectoryWatcher watcher{ std::make_unique<PollingWatchBackend>(a_dir, kInterval), kDebounce, [&] {
+                                         recorder.OnChanged();
+                                         throw 42;
+                                     } };
+
+            Write(a_dir / "e.toml", "iE = 1\n");
+            Check(recorder.WaitFor(1), "a change was not reported");
+            Write(a_dir / "e.toml", "iE = 22\n");
+            Check(recorder.WaitFor(2), "the watcher stopped after its callback threw");
+        }
+        std::filesystem::remove(a_dir / "e.toml");
+    }
+
+    void TestCancel(const std::filesystem::path& a_dir)
+    {
+        // Waiting with no timeout returns as soon as it is cancelled.
+        PollingWatchBackend backend{ a_dir, 1h };
+        auto                wait = std::async(std::launch::async, [&] { return backend.Wait(std::nullopt); });
+        std::this_thread::sleep_for(kInterval);
+        backend.Cancel();
+        if (Check(wait.wait_for(kTimeout) == std::future_status::ready, "Cancel did not wake up Wait")) {
+            Check(wait.get() == WatchBackend::Result::kCancelled, "Wait did not report the cancellation");
+        }
+
+        // And a timeout is reported as one.
+        PollingWatchBackend idle{ a_dir, kInterval };
+        Check(idle.Wait(5 * kInterval) == WatchBackend::Result::kTimeout, "an idle directory did not time out");
+    }
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path() / "ccld_GameSettingsOverride_DirectoryWatcherTest";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    Run(dir);
+    TestThrowingCallback(dir);
+    TestCancel(dir);
+
+    std::filesystem::remove_all(dir);
+    return Test::Finish();
+}
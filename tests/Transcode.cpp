@@ -0,0 +1,394 @@
+// Compares the buffer-based UTF-8/UTF-16 conversion with a plain scalar
+// reference, for input that starts at every alignment and has its interesting
+// part at every position of a vector-sized ASCII run, and the lossy conversion
+// that replaces unpaired surrogates.
+
+#include <XSEPlugin/Util/Transcode.h>
+
+#include "Check.h"
+
+using Test::Check;
+
+namespace
+{
+    /// Bytes written around each output buffer, which must stay as they are.
+    constexpr std::size_t kGuard = 32;
+    constexpr char        kCanary = 0x5A;
+
+    /// Offsets that cover every position within a vector.
+    constexpr std::size_t kAlignments = 16;
+
+    /// Long enough for two vectors of ASCII on either side of any position.
+    constexpr std::size_t kRun = 40;
+
+    [[nodiscard]] std::optional<std::u32string> DecodeUtf16(std::u16string_view a_in)
+    {
+        std::u32string out;
+        for (std::size_t i = 0; i < a_in.size(); ++i) {
+            const char32_t unit = a_in[i];
+            if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                return std::nullopt;
+            }
+            if (unit >= 0xD800 && unit <= 0xDBFF) {
+                if (i + 1 == a_in.size() || a_in[i + 1] < 0xDC00 || a_in[i + 1] > 0xDFFF) {
+                    return std::nullopt;
+                }
+                out += 0x10000 + ((unit - 0xD800) << 10) + (a_in[++i] - 0xDC00);
+                continue;
+            }
+            out += unit;
+        }
+        return out;
+    }
+
+    /// Well-formed byte sequences, as listed in table 3-7 of the Unicode standard.
+    [[nodiscard]] std::optional<std::u32string> DecodeUtf8(std::string_view a_in)
+    {
+        struct Form
+        {
+            unsigned char leadMin;
+            unsigned char leadMax;
+            unsigned char secondMin;
+            unsigned char secondMax;
+            int           size;
+        };
+
+        constexpr Form kForms[] = {
+            { 0x00, 0x7F, 0x00, 0x00, 1 },
+            { 0xC2, 0xDF, 0x80, 0xBF, 2 },
+            { 0xE0, 0xE0, 0xA0, 0xBF, 3 },
+            { 0xE1, 0xEC, 0x80, 0xBF, 3 },
+            { 0xED, 0xED, 0x80, 0x9F, 3 },
+            { 0xEE, 0xEF, 0x80, 0xBF, 3 },
+            { 0xF0, 0xF0, 0x90, 0xBF, 4 },
+            { 0xF1, 0xF3, 0x80, 0xBF, 4 },
+            { 0xF4, 0xF4, 0x80, 0x8F, 4 },
+        };
+
+        std::u32string out;
+        for (std::size_t i = 0; i < a_in.size();) {
+            const auto  lead = static_cast<unsigned char>(a_in[i]);
+            const auto* form = std::ranges::find_if(kForms, [&](const Form& a_form) {
+                return lead >= a_form.leadMin && lead <= a_form.leadMax;
+            });
+            if (form == std::ranges::end(kForms) || a_in.size() - i < static_cast<std::size_t>(form->size)) {
+                return std::nullopt;
+            }
+
+            char32_t cp = form->size == 1 ? lead : lead & (0x3F >> (form->size - 1));
+            for (int n = 1; n < form->size; ++n) {
+                const auto byte = static_cast<unsigned char>(a_in[i + n]);
+                const auto min = n == 1 ? form->secondMin : 0x80;
+                const auto max = n == 1 ? form->secondMax : 0xBF;
+                if (byte < min || byte > max) {
+                    return std::nullopt;
+                }
+                cp = (cp << 6) | (byte & 0x3F);
+            }
+            out += cp;
+            i += form->size;
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::string EncodeUtf8(std::u32string_view a_in)
+    {
+        std::string out;
+        for (const auto cp : a_in) {
+            if (cp < 0x80) {
+                out += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::u16string EncodeUtf16(std::u32string_view a_in)
+    {
+        std::u16string out;
+        for (const auto cp : a_in) {
+            if (cp < 0x10000) {
+                out += static_cast<char16_t>(cp);
+            } else {
+                out += static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+                out += static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+            }
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::optional<std::string> ReferenceUtf16ToUtf8(std::u16string_view a_in)
+    {
+        auto cps = DecodeUtf16(a_in);
+        return cps ? std::optional{ EncodeUtf8(*cps) } : std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<std::u16string> ReferenceUtf8ToUtf16(std::string_view a_in)
+    {
+        auto cps = DecodeUtf8(a_in);
+        return cps ? std::optional{ EncodeUtf16(*cps) } : std::nullopt;
+    }
+
+    template <class T>
+    [[nodiscard]] std::string Describe(std::basic_string_view<T> a_in)
+    {
+        std::string out;
+        for (const auto unit : a_in) {
+            out += std::format("{:0{}X} ", static_cast<std::make_unsigned_t<T>>(unit), sizeof(T) * 2);
+        }
+        return out;
+    }
+
+    /// Convert `a_in` placed at `a_inOffset` into a buffer of `a_capacity` at
+    /// `a_outOffset`, and check the result and that nothing around the buffer
+    /// was written.
+    template <class In, class Out, class Convert, class Expected>
+    void CheckOnce(std::basic_string_view<In> a_in, std::size_t a_inOffset, std::size_t a_capacity,
+        std::size_t a_outOffset, Convert&& a_convert, const Expected& a_expected)
+    {
+        std::vector<In> input(a_inOffset + a_in.size());
+        std::ranges::copy(a_in, input.begin() + a_inOffset);
+
+        std::vector<Out> output(kGuard + a_outOffset + a_capacity + kGuard, static_cast<Out>(kCanary));
+        const auto       out = std::span{ output }.subspan(kGuard + a_outOffset, a_capacity);
+
+        const auto result = a_convert(std::basic_string_view<In>{ input.data() + a_inOffset, a_in.size() }, out);
+        const auto fits = a_expected && a_expected->size() <= a_capacity;
+        const auto what = std::format("input {}at offset {}, capacity {} at offset {}", Describe(a_in), a_inOffset,
+            a_capacity, a_outOffset);
+
+        if (Check(result.has_value() == fits, what + ": accepted " + (result ? "" : "not ") + "as expected") &&
+            result) {
+            Check(std::ranges::equal(out.first(*result), *a_expected), what + ": output differs");
+        }
+
+        const auto untouched = [](auto a_range) {
+            return std::ranges::all_of(a_range, [](Out a_unit) { return a_unit == static_cast<Out>(kCanary); });
+        };
+        Check(untouched(std::span{ output }.first(kGuard + a_outOffset)) &&
+                  untouched(std::span{ output }.subspan(kGuard + a_outOffset + a_capacity)),
+            what + ": wrote outside the buffer");
+    }
+
+    /// Every alignment of input and output, with room to spare and exactly
+    /// enough room, and every smaller buffer at one alignment.
+    template <class In, class Out, class Convert, class Expected>
+    void CheckAll(std::basic_string_view<In> a_in, std::size_t a_maxSize, Convert&& a_convert,
+        const Expected& a_expected)
+    {
+        for (std::size_t inOffset = 0; inOffset < kAlignments; ++inOffset) {
+            for (std::size_t outOffset = 0; outOffset < kAlignments; ++outOffset) {
+                CheckOnce<In, Out>(a_in, inOffset, a_maxSize, outOffset, a_convert, a_expected);
+                if (a_expected) {
+                    CheckOnce<In, Out>(a_in, inOffset, a_expected->size(), outOffset, a_convert, a_expected);
+                }
+            }
+        }
+
+        if (a_expected) {
+            for (std::size_t capacity = 0; capacity < a_expected->size(); ++capacity) {
+                CheckOnce<In, Out>(a_in, 0, capacity, 0, a_convert, a_expected);
+            }
+        }
+    }
+
+    void CheckUtf16(std::u16string_view a_in)
+    {
+        const auto expected = ReferenceUtf16ToUtf8(a_in);
+        CheckAll<char16_t, char>(a_in, MaxUtf8Size(a_in.size()),
+            [](std::u16string_view a_src, std::span<char> a_dst) { return Utf16ToUtf8(a_src, a_dst); }, expected);
+
+        Check(Utf16ToUtf8(a_in) == expected, "allocating Utf16ToUtf8 differs for " + Describe(a_in));
+    }
+
+    void CheckUtf8(std::string_view a_in)
+    {
+        const auto expected = ReferenceUtf8ToUtf16(a_in);
+        CheckAll<char, char16_t>(a_in, MaxUtf16Size(a_in.size()),
+            [](std::string_view a_src, std::span<char16_t> a_dst) { return Utf8ToUtf16(a_src, a_dst); }, expected);
+
+        Check(Utf8ToUtf16(a_in) == expected, "allocating Utf8ToUtf16 differs for " + Describe(a_in));
+    }
+
+    /// Both directions of valid text, which must also round-trip.
+    void CheckValid(std::u32string_view a_text)
+    {
+        const auto utf8 = EncodeUtf8(a_text);
+        const auto utf16 = EncodeUtf16(a_text);
+        CheckUtf16(utf16);
+        CheckUtf8(utf8);
+        Check(Utf16ToUtf8(utf16) == utf8, "Utf16ToUtf8 does not match the encoding of " + Describe(a_text));
+        Check(Utf8ToUtf16(utf8) == utf16, "Utf8ToUtf16 does not match the encoding of " + Describe(a_text));
+        Check(Utf16ToUtf8Lossy(utf16) == utf8, "Utf16ToUtf8Lossy changes valid " + Describe(a_text));
+    }
+
+    [[nodiscard]] std::u32string ASCII(std::size_t a_size)
+    {
+        std::u32string out;
+        for (std::size_t i = 0; i < a_size; ++i) {
+            out += static_cast<char32_t>('a' + i % 26);
+        }
+        return out;
+    }
+
+    /// `a_part` at every position of an ASCII run.
+    template <class T>
+    [[nodiscard]] std::vector<std::basic_string<T>> Embed(std::basic_string_view<T> a_part)
+    {
+        std::vector<std::basic_string<T>> out;
+        for (std::size_t pos = 0; pos <= kRun; ++pos) {
+            std::basic_string<T> str;
+            for (const auto cp : ASCII(kRun)) {
+                str += static_cast<T>(cp);
+            }
+            str.insert(pos, a_part);
+            out.push_back(std::move(str));
+        }
+        return out;
+    }
+
+    void TestASCII()
+    {
+        for (std::size_t size = 0; size <= 2 * kRun; ++size) {
+            CheckValid(ASCII(size));
+        }
+    }
+
+    void TestMixed()
+    {
+        // Sizes 1 to 4 in UTF-8, and the bounds of each.
+        constexpr char32_t kCodePoints[] = {
+            0x7F, 0x80, 0xE9, 0x7FF, 0x800, 0x20AC, 0xD7FF, 0xE000, 0xFFFF, 0x10000, 0x1F600, 0x10FFFF
+        };
+
+        for (const auto cp : kCodePoints) {
+            for (const auto& text : Embed(std::u32string_view{ &cp, 1 })) {
+                CheckValid(text);
+            }
+        }
+
+        CheckValid(U"fJumpHeightMin été € \U0001F600 sNameAßcd \U0010FFFF end");
+        CheckValid(U"éééééééééééééééé");
+        CheckValid(U"\U0001F600\U0001F601\U0001F602\U0001F603\U0001F604\U0001F605\U0001F606\U0001F607\U0001F608");
+    }
+
+    void TestInvalidUtf16()
+    {
+        constexpr std::u16string_view kInvalid[] = {
+            u"\xD800",
+            u"\xDBFF",
+            u"\xDC00",
+            u"\xDFFF",
+            u"\xDC00\xD800",
+            u"\xD800\xD800",
+            u"\xD800" u"a",
+        };
+
+        for (const auto part : kInvalid) {
+            for (const auto& str : Embed(part)) {
+                Check(!ReferenceUtf16ToUtf8(str), "reference accepts " + Describe(std::u16string_view{ str }));
+                CheckUtf16(str);
+            }
+        }
+
+        // Cut off after the high surrogate.
+        auto truncated = EncodeUtf16(ASCII(kRun) + U"\U0001F600");
+        truncated.pop_back();
+        CheckUtf16(truncated);
+    }
+
+    void TestLossyUtf16()
+    {
+        // Each unpaired surrogate becomes one U+FFFD, and the rest is kept.
+        struct Case
+        {
+            std::u16string_view in;
+            std::u32string_view out;
+        };
+
+        constexpr Case kCases[] = {
+            { u"\xD800", U"\uFFFD" },
+            { u"\xDFFF", U"\uFFFD" },
+            { u"\xDC00\xD800", U"\uFFFD\uFFFD" },
+            { u"\xD800\xD800\xDC00", U"\uFFFD\U00010000" },
+            { u"\xD800" u"a", U"\uFFFDa" },
+            { u"\xE9\xDC00\x20AC", U"\xE9\uFFFD\u20AC" },
+        };
+
+        for (const auto& [in, out] : kCases) {
+            const auto parts = Embed(in);
+            const auto expected = Embed(out);
+            for (std::size_t i = 0; i < parts.size(); ++i) {
+                Check(Utf16ToUtf8Lossy(parts[i]) == EncodeUtf8(expected[i]),
+                    "Utf16ToUtf8Lossy differs for " + Describe(std::u16string_view{ parts[i] }));
+            }
+        }
+
+        // Cut off after the high surrogate.
+        auto truncated = EncodeUtf16(ASCII(kRun) + U"\U0001F600");
+        truncated.pop_back();
+        Check(Utf16ToUtf8Lossy(truncated) == EncodeUtf8(ASCII(kRun) + U"\uFFFD"),
+            "Utf16ToUtf8Lossy differs for a truncated pair");
+    }
+
+    void TestInvalidUtf8()
+    {
+        constexpr std::string_view kInvalid[] = {
+            "\x80",              // Continuation without a lead byte.
+            "\xBF",              //
+            "\xC0\x80",          // Overlong forms.
+            "\xC1\xBF",          //
+            "\xE0\x80\x80",      //
+            "\xE0\x9F\xBF",      //
+            "\xF0\x80\x80\x80",  //
+            "\xF0\x8F\xBF\xBF",  //
+            "\xED\xA0\x80",      // Surrogates.
+            "\xED\xBF\xBF",      //
+            "\xF4\x90\x80\x80",  // Past U+10FFFF.
+            "\xF5\x80\x80\x80",  //
+            "\xF8\x88\x80\x80\x80",
+            "\xFE",
+            "\xFF",
+            "\xC3" "a",          // Missing continuation bytes.
+            "\xE2\x82" "a",      //
+            "\xF0\x9F\x98" "a",  //
+        };
+
+        for (const auto part : kInvalid) {
+            for (const auto& str : Embed(part)) {
+                Check(!ReferenceUtf8ToUtf16(str), "reference accepts " + Describe(std::string_view{ str }));
+                CheckUtf8(str);
+            }
+        }
+
+        // Cut off within a sequence at the very end.
+        for (const std::string_view part : { "\xC3"sv, "\xE2\x82"sv, "\xF0\x9F\x98"sv, "\xE2"sv, "\xF0"sv }) {
+            for (std::size_t size = 0; size <= 2 * kRun; ++size) {
+                auto str = EncodeUtf8(ASCII(size));
+                str += part;
+                CheckUtf8(str);
+            }
+        }
+    }
+}
+
+int main()
+{
+    TestASCII();
+    TestMixed();
+    TestInvalidUtf16();
+    TestLossyUtf16();
+    TestInvalidUtf8();
+    return Test::Finish();
+}